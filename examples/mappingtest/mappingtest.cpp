@@ -0,0 +1,973 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <ratio>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <llama/llama.hpp>
+
+/* Checks mappings and views by writing values and reading them back. Every
+ * check prints its number of errors and the example fails if any check does.
+ */
+
+namespace st
+{
+    struct Id {};
+    struct Flag {};
+    struct Value {};
+    struct Weight {};
+    struct Count {};
+    struct Hits {};
+    struct Tracks {};
+    struct X {};
+    struct Y {};
+}
+
+using Sample = llama::DS<
+    llama::DE< st::Id, std::uint16_t >,
+    llama::DE< st::Flag, bool >,
+    llama::DE< st::Value, double >,
+    llama::DE< st::Weight, float >,
+    llama::DE< st::Count, std::int32_t >
+>;
+
+using Track = llama::DS<
+    llama::DE< st::X, float >,
+    llama::DE< st::Y, double >
+>;
+
+using Event = llama::DS<
+    llama::DE< st::Id, int >,
+    llama::DE< st::Hits, llama::DA< int, 4 > >,
+    llama::DE< st::Tracks, llama::DA< Track, 3 > >
+>;
+
+using UD = llama::UserDomain< 1 >;
+constexpr std::size_t elements = 64;
+
+auto
+report(
+    char const * const name,
+    std::size_t const errors
+)
+-> std::size_t
+{
+    std::cout << name << ": " << errors << " errors\n";
+    return errors;
+}
+
+template< typename T_View >
+auto
+fillSamples(
+    T_View & view,
+    double const scale
+)
+-> void
+{
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        view( i )( st::Id() ) = std::uint16_t( i * 31 % 2048 );
+        view( i )( st::Flag() ) = i % 3 == 0;
+        view( i )( st::Value() ) = ( double( i ) - 32.0 ) * scale;
+        view( i )( st::Weight() ) = float( i ) / float( elements );
+        view( i )( st::Count() ) = std::int32_t( i * 97 ) - 3000;
+    }
+}
+
+/** Compares the read back samples with the written ones, allowing a
+ *  difference of `valueError` and `weightError` for the floating point
+ *  leaves
+ */
+template< typename T_View >
+auto
+checkSamples(
+    T_View & view,
+    double const scale,
+    double const valueError,
+    double const weightError
+)
+-> std::size_t
+{
+    std::size_t errors = 0;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        double const value = view( i )( st::Value() );
+        float const weight = view( i )( st::Weight() );
+        errors += std::uint16_t( view( i )( st::Id() ) ) != i * 31 % 2048;
+        errors += bool( view( i )( st::Flag() ) ) != ( i % 3 == 0 );
+        errors += std::abs( value - ( double( i ) - 32.0 ) * scale )
+            > valueError;
+        errors += std::abs( weight - float( i ) / float( elements ) )
+            > weightError;
+        errors += std::int32_t( view( i )( st::Count() ) )
+            != std::int32_t( i * 97 ) - 3000;
+    }
+    return errors;
+}
+
+template< typename T_Mapping >
+auto
+roundTrip(
+    char const * const name,
+    T_Mapping const mapping,
+    double const scale,
+    double const valueError,
+    double const weightError
+)
+-> std::size_t
+{
+    auto view = llama::Factory<
+        T_Mapping,
+        llama::allocator::Vector<>
+    >::allocView( mapping );
+    fillSamples( view, scale );
+    return report(
+        name,
+        checkSamples( view, scale, valueError, weightError )
+    );
+}
+
+/// checks that \ref llama::mapping::ByteSwap really stores swapped bytes
+auto
+byteSwapStorage()
+-> std::size_t
+{
+    using Mapping = llama::mapping::ByteSwap<
+        UD,
+        Sample,
+        llama::mapping::AoS
+    >;
+    Mapping const mapping( UD{ elements } );
+    auto view = llama::Factory<
+        Mapping,
+        llama::allocator::Vector<>
+    >::allocView( mapping );
+    fillSamples( view, 1.0 );
+    std::size_t errors = 0;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        std::int32_t stored;
+        std::memcpy(
+            &stored,
+            &view.blob[ mapping.getBlobNr< 4 >( { i } ) ][
+                mapping.getBlobByte< 4 >( { i } )
+            ],
+            sizeof( stored )
+        );
+        errors += llama::mapping::byteSwap( stored )
+            != std::int32_t( i * 97 ) - 3000;
+    }
+    return report( "ByteSwap storage", errors );
+}
+
+template< typename T_Mapping >
+auto
+arrayAccess( char const * const name )
+-> std::size_t
+{
+    auto view = llama::Factory<
+        T_Mapping,
+        llama::allocator::Vector<>
+    >::allocView( T_Mapping( UD{ elements } ) );
+    for ( std::size_t u = 0; u < elements; ++u )
+    {
+        for ( std::size_t i = 0; i < 4; ++i )
+            view.template arrayAccessor< llama::DatumCoord< 1 > >(
+                UD{ u },
+                i
+            ) = int( 10 * u + i );
+        for ( std::size_t i = 0; i < 3; ++i )
+        {
+            view( u ).template at< st::Tracks >(
+                i,
+                llama::DatumCoord< 0 >()
+            ) = float( i );
+            view( u ).template at< st::Tracks >(
+                i,
+                llama::DatumCoord< 1 >()
+            ) = double( u ) + double( i ) / 4.0;
+        }
+    }
+    std::size_t errors = 0;
+    for ( std::size_t u = 0; u < elements; ++u )
+    {
+        errors += view( u ).template access< 1, 0 >() != int( 10 * u );
+        errors += view( u ).template access< 1, 3 >() != int( 10 * u + 3 );
+        errors += view( u ).template access< 2, 0, 1 >() != double( u );
+        errors += view( u ).template access< 2, 2, 1 >()
+            != double( u ) + 0.5;
+        errors += view( u ).template access< 2, 1, 0 >() != 1.0f;
+    }
+    return report( name, errors );
+}
+
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain
+>
+using AoSoA8 = llama::mapping::AoSoA<
+    T_UserDomain,
+    T_DatumDomain,
+    8
+>;
+
+/// stores the folded array in an own user domain dimension
+auto
+foldArray()
+-> std::size_t
+{
+    using Mapping = llama::mapping::FoldArray<
+        UD,
+        llama::DS<
+            llama::DE< st::Id, int >,
+            llama::DE< st::Hits, llama::DA< int, 4 > >
+        >,
+        llama::DatumCoord< 1 >,
+        llama::mapping::SoA
+    >;
+    auto view = llama::Factory<
+        Mapping,
+        llama::allocator::Vector<>
+    >::allocView( Mapping( UD{ elements } ) );
+    for ( std::size_t u = 0; u < elements; ++u )
+    {
+        view( u )( st::Id() ) = -int( u );
+        view( u ).access< 1, 0 >() = int( 10 * u );
+        view( u ).access< 1, 1 >() = int( 10 * u + 1 );
+        view( u ).access< 1, 2 >() = int( 10 * u + 2 );
+        view( u ).access< 1, 3 >() = int( 10 * u + 3 );
+    }
+    std::size_t errors = 0;
+    for ( std::size_t u = 0; u < elements; ++u )
+    {
+        errors += view( u )( st::Id() ) != -int( u );
+        errors += view( u ).access< 1, 0 >() != int( 10 * u );
+        errors += view( u ).access< 1, 3 >() != int( 10 * u + 3 );
+    }
+    // only the folded array can be indexed at run time
+    for ( std::size_t u = 0; u < elements; ++u )
+        for ( std::size_t i = 0; i < 4; ++i )
+        {
+            errors += view.arrayAccessor< llama::DatumCoord< 1 > >(
+                UD{ u },
+                i
+            ) != int( 10 * u + i );
+            view( u ).at< st::Hits >( i ) = int( 20 * u + i );
+        }
+    errors += view( 3 ).access< 1, 2 >() != 62;
+    return report( "FoldArray", errors );
+}
+
+/// writes and reads back samples exactly, without reporting
+template< typename T_Mapping >
+auto
+checkLayout( T_Mapping const mapping )
+-> std::size_t
+{
+    auto view = llama::Factory<
+        T_Mapping,
+        llama::allocator::Vector<>
+    >::allocView( mapping );
+    fillSamples( view, 1.0 );
+    return checkSamples( view, 1.0, 0.0, 0.0 );
+}
+
+/** checks the padded leaves and the stride of
+ *  \ref llama::mapping::AlignedAoS, whose sample is 24 byte big
+ */
+template< typename T_StrideFunctor >
+auto
+alignedAoS(
+    char const * const name,
+    std::size_t const stride
+)
+-> std::size_t
+{
+    using Mapping = llama::mapping::AlignedAoS<
+        UD,
+        Sample,
+        T_StrideFunctor
+    >;
+    Mapping const mapping( UD{ elements } );
+    std::size_t errors = checkLayout( mapping );
+    errors += Mapping::stride != stride;
+    errors += mapping.getBlobSize( 0 ) != elements * stride;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        errors += mapping.template getBlobByte< 0 >( { i } ) != i * stride;
+        errors += mapping.template getBlobByte< 1 >( { i } ) != i * stride + 2;
+        errors += mapping.template getBlobByte< 2 >( { i } ) != i * stride + 8;
+        errors += mapping.template getBlobByte< 3 >( { i } ) != i * stride + 16;
+        errors += mapping.template getBlobByte< 4 >( { i } ) != i * stride + 20;
+    }
+    return report( name, errors );
+}
+
+/** checks that every leaf array of \ref llama::mapping::AlignedSoA starts at
+ *  a multiple of the alignment, with the user domain padded to it
+ */
+template< std::size_t T_alignment >
+auto
+alignedSoA( char const * const name )
+-> std::size_t
+{
+    using Mapping = llama::mapping::AlignedSoA<
+        UD,
+        Sample,
+        T_alignment
+    >;
+    Mapping const mapping( UD{ elements } );
+    std::size_t const extent =
+        ( elements + T_alignment - 1 ) / T_alignment * T_alignment;
+    std::size_t errors = checkLayout( mapping );
+    errors += llama::mapping::FieldAlignment< Mapping >::value
+        != T_alignment;
+    // plain SoA gives no alignment guarantee
+    errors += llama::mapping::FieldAlignment<
+        llama::mapping::SoA< UD, Sample >
+    >::value != 1;
+    errors += mapping.extentUserDomainAdress != extent;
+    errors += mapping.getBlobSize( 0 )
+        != extent * llama::SizeOf< Sample >::value;
+    errors += mapping.template getBlobByte< 1 >( { 0 } ) != 2 * extent;
+    errors += mapping.template getBlobByte< 2 >( { 0 } ) != 3 * extent;
+    errors += mapping.template getBlobByte< 4 >( { 0 } ) != 15 * extent;
+    errors += mapping.template getBlobByte< 0 >( { 0 } ) % T_alignment
+        + mapping.template getBlobByte< 1 >( { 0 } ) % T_alignment
+        + mapping.template getBlobByte< 2 >( { 0 } ) % T_alignment
+        + mapping.template getBlobByte< 3 >( { 0 } ) % T_alignment
+        + mapping.template getBlobByte< 4 >( { 0 } ) % T_alignment;
+    for ( std::size_t i = 0; i < elements; ++i )
+        errors += mapping.template getBlobByte< 2 >( { i } )
+            != 3 * extent + i * sizeof( double );
+    return report( name, errors );
+}
+
+/** checks where \ref llama::mapping::Reorder puts the leaves of a sample
+ *  with an inner \ref llama::mapping::AoS, given as the byte offset of
+ *  every leaf in its original order
+ */
+template<
+    typename T_OrderPolicy,
+    typename T_Permutation
+>
+auto
+reorder(
+    char const * const name,
+    std::size_t const ( & offsets )[ 5 ]
+)
+-> std::size_t
+{
+    using Mapping = llama::mapping::Reorder<
+        UD,
+        Sample,
+        llama::mapping::AoS,
+        T_OrderPolicy
+    >;
+    Mapping const mapping( UD{ elements } );
+    std::size_t const stride = llama::SizeOf< Sample >::value;
+    std::size_t errors = checkLayout( mapping );
+    errors += !std::is_same<
+        typename Mapping::Permutation,
+        T_Permutation
+    >::value;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        errors += mapping.template getBlobByte< 0 >( { i } )
+            != i * stride + offsets[ 0 ];
+        errors += mapping.template getBlobByte< 1 >( { i } )
+            != i * stride + offsets[ 1 ];
+        errors += mapping.template getBlobByte< 2 >( { i } )
+            != i * stride + offsets[ 2 ];
+        errors += mapping.template getBlobByte< 3 >( { i } )
+            != i * stride + offsets[ 3 ];
+        errors += mapping.template getBlobByte< 4 >( { i } )
+            != i * stride + offsets[ 4 ];
+    }
+    return report( name, errors );
+}
+
+/** checks that \ref llama::mapping::Split puts the value and the count of a
+ *  sample into the SoA blob and all other leaves into the AoS blob behind it
+ */
+auto
+split()
+-> std::size_t
+{
+    using Mapping = llama::mapping::Split<
+        UD,
+        Sample,
+        boost::mp11::mp_list<
+            llama::DatumCoord< 2 >,
+            llama::DatumCoord< 4 >
+        >,
+        llama::mapping::SoA,
+        llama::mapping::AoS
+    >;
+    Mapping const mapping( UD{ elements } );
+    // id, flag and weight are packed into 7 byte
+    std::size_t const stride = 7;
+    std::size_t errors = checkLayout( mapping );
+    errors += Mapping::blobCount != 2;
+    errors += mapping.getBlobSize( 0 ) != elements * 12;
+    errors += mapping.getBlobSize( 1 ) != elements * stride;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        errors += mapping.getBlobNr< 0 >( { i } ) != 1;
+        errors += mapping.getBlobNr< 1 >( { i } ) != 1;
+        errors += mapping.getBlobNr< 2 >( { i } ) != 0;
+        errors += mapping.getBlobNr< 3 >( { i } ) != 1;
+        errors += mapping.getBlobNr< 4 >( { i } ) != 0;
+        errors += mapping.getBlobByte< 0 >( { i } ) != i * stride;
+        errors += mapping.getBlobByte< 1 >( { i } ) != i * stride + 2;
+        errors += mapping.getBlobByte< 2 >( { i } ) != i * 8;
+        errors += mapping.getBlobByte< 3 >( { i } ) != i * stride + 3;
+        errors += mapping.getBlobByte< 4 >( { i } )
+            != elements * 8 + i * 4;
+    }
+    return report( "Split", errors );
+}
+
+/** checks that a linearizer maps every coordinate of a non power of two
+ *  user domain to its own index below the extent of the domain, using a
+ *  \ref llama::mapping::SoA of a single byte so that the byte offset is the
+ *  index
+ */
+template<
+    typename T_Linearize,
+    typename T_Extent
+>
+auto
+bijective( char const * const name )
+-> std::size_t
+{
+    using UD2 = llama::UserDomain< 2 >;
+    using Mapping = llama::mapping::SoA<
+        UD2,
+        llama::DS< llama::DE< st::Id, std::uint8_t > >,
+        T_Linearize,
+        T_Extent
+    >;
+    UD2 const size{ 5, 3 };
+    Mapping const mapping( size );
+    std::size_t const extent = mapping.getBlobSize( 0 );
+    std::vector< bool > used( extent, false );
+    std::size_t errors = 0;
+    for ( std::size_t x = 0; x < size[ 0 ]; ++x )
+        for ( std::size_t y = 0; y < size[ 1 ]; ++y )
+        {
+            std::size_t const index =
+                mapping.template getBlobByte< 0 >( { x, y } );
+            if ( index >= extent || used[ index ] )
+                ++errors;
+            else
+                used[ index ] = true;
+        }
+    return report( name, errors );
+}
+
+/** checks that a triangular linearizer maps every coordinate of the stored
+ *  triangle of a 5x5 user domain to its own index, filling the extent
+ *  completely, and every mirrored coordinate to the same index
+ */
+template<
+    typename T_Triangle,
+    bool T_withDiagonal
+>
+auto
+triangular( char const * const name )
+-> std::size_t
+{
+    using UD2 = llama::UserDomain< 2 >;
+    using Mapping = llama::mapping::SoA<
+        UD2,
+        llama::DS< llama::DE< st::Id, std::uint8_t > >,
+        llama::LinearizeUserDomainAdressTriangular<
+            T_Triangle,
+            T_withDiagonal
+        >,
+        llama::ExtentUserDomainAdressTriangular< T_withDiagonal >
+    >;
+    std::size_t const n = 5;
+    Mapping const mapping( UD2{ n, n } );
+    std::size_t const extent = mapping.getBlobSize( 0 );
+    std::vector< bool > used( extent, false );
+    std::size_t errors = extent != ( T_withDiagonal ? 15 : 10 );
+    for ( std::size_t x = 0; x < n; ++x )
+        for ( std::size_t y = 0; y < n; ++y )
+        {
+            bool const stored = std::is_same<
+                T_Triangle,
+                llama::UpperTriangle
+            >::value ? x < y : y < x;
+            if ( !stored && !( T_withDiagonal && x == y ) )
+                continue;
+            std::size_t const index =
+                mapping.template getBlobByte< 0 >( { x, y } );
+            if ( index >= extent || used[ index ] )
+                ++errors;
+            else
+                used[ index ] = true;
+            errors += mapping.template getBlobByte< 0 >( { y, x } ) != index;
+        }
+    for ( std::size_t i = 0; i < extent; ++i )
+        errors += !used[ i ];
+    return report( name, errors );
+}
+
+/** checks that \ref llama::mapping::SparseBlockGrid activates blocks on
+ *  writing, reads the background for all other blocks and refuses to
+ *  activate more blocks than fit into its pool
+ */
+auto
+sparseBlockGrid()
+-> std::size_t
+{
+    using Mapping = llama::mapping::SparseBlockGrid<
+        UD,
+        Sample,
+        llama::mapping::SoA,
+        8
+    >;
+    // 8 blocks, but only 2 of them fit into the pool
+    Mapping const mapping( UD{ elements }, 2 );
+    auto view = llama::Factory<
+        Mapping,
+        llama::allocator::Vector<>
+    >::allocView( mapping );
+    // the background and the pool are as uninitialized as the blob
+    std::memset( &view.blob[ 0 ][ 0 ], 0, mapping.getBlobSize( 0 ) );
+    std::size_t errors = mapping.activeBlockCount() != 0;
+    view( 3u )( st::Value() ) = 1.5;
+    errors += mapping.activeBlockCount() != 1;
+    errors += !mapping.isActive( { 7 } );
+    errors += mapping.isActive( { 8 } );
+    errors += !mapping.activate( { 20 } );
+    errors += !mapping.activate( { 23 } );
+    errors += mapping.activeBlockCount() != 2;
+    errors += mapping.activate( { 40 } );
+    errors += mapping.isActive( { 40 } );
+    errors += mapping.activeBlockCount() != 2;
+    for ( std::size_t i = 16; i < 24; ++i )
+    {
+        view( i )( st::Count() ) = std::int32_t( i );
+        view( i )( st::Weight() ) += 0.5f;
+    }
+    errors += double( view( 3u )( st::Value() ) ) != 1.5;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        bool const active = i < 8 || ( i >= 16 && i < 24 );
+        errors += mapping.isActive( { i } ) != active;
+        errors += std::int32_t( view( i )( st::Count() ) )
+            != ( i >= 16 && i < 24 ? std::int32_t( i ) : 0 );
+        errors += float( view( i )( st::Weight() ) )
+            != ( i >= 16 && i < 24 ? 0.5f : 0.0f );
+        errors += double( view( i )( st::Value() ) )
+            != ( i == 3 ? 1.5 : 0.0 );
+    }
+    return report( "SparseBlockGrid", errors );
+}
+
+/// product of the value and the weight of a sample
+struct WeightedValue
+{
+    template< typename T_Datum >
+    auto
+    operator()( T_Datum const & datum ) const
+    -> double
+    {
+        return datum( st::Value() ) * datum( st::Weight() );
+    }
+};
+
+/** checks that \ref llama::mapping::Computed computes a leaf without storage
+ *  and that whole datum copies skip it, but still copy it into views which
+ *  store it
+ */
+auto
+computed()
+-> std::size_t
+{
+    using Weighted = llama::DS<
+        llama::DE< st::Value, double >,
+        llama::DE< st::Weight, float >,
+        llama::DE< st::Count, double >
+    >;
+    using Mapping = llama::mapping::Computed<
+        UD,
+        Weighted,
+        boost::mp11::mp_list< llama::mapping::ComputedField<
+            llama::DatumCoord< 2 >,
+            WeightedValue
+        > >
+    >;
+    using Stored = llama::mapping::SoA<
+        UD,
+        Weighted
+    >;
+    static_assert(
+        !std::is_assignable<
+            llama::mapping::ComputedRef< double >,
+            double
+        >::value,
+        "Computed leaves should not be writable"
+    );
+    Mapping const mapping( UD{ elements } );
+    auto source = llama::Factory<
+        Mapping,
+        llama::allocator::Vector<>
+    >::allocView( mapping );
+    auto copy = llama::Factory<
+        Mapping,
+        llama::allocator::Vector<>
+    >::allocView( mapping );
+    auto stored = llama::Factory<
+        Stored,
+        llama::allocator::Vector<>
+    >::allocView( Stored( UD{ elements } ) );
+    // only the value and the weight are stored
+    std::size_t errors = mapping.getBlobSize( 0 ) != elements * 12;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        source( i )( st::Value() ) = double( i );
+        source( i )( st::Weight() ) = 0.5f;
+    }
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        copy( i ) = source( i );
+        stored( i ) = source( i );
+        copy( i ) *= 2.0;
+    }
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        errors += double( source( i )( st::Count() ) ) != double( i ) / 2.0;
+        errors += double( copy( i )( st::Value() ) ) != double( i ) * 2.0;
+        errors += double( copy( i )( st::Count() ) ) != double( i ) * 2.0;
+        errors += stored( i )( st::Count() ) != double( i ) / 2.0;
+    }
+    return report( "Computed", errors );
+}
+
+/** checks that \ref llama::mapping::Uniform stores the weight of all
+ *  samples once in the first blob, while the other leaves stay per sample
+ */
+auto
+uniform()
+-> std::size_t
+{
+    using Mapping = llama::mapping::Uniform<
+        UD,
+        Sample,
+        boost::mp11::mp_list< llama::DatumCoord< 3 > >
+    >;
+    Mapping const mapping( UD{ elements } );
+    auto view = llama::Factory<
+        Mapping,
+        llama::allocator::Vector<>
+    >::allocView( mapping );
+    std::size_t errors = mapping.getBlobSize( 0 ) != sizeof( float );
+    errors += mapping.getBlobSize( 1 ) != elements * 15;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        errors += mapping.getBlobNr< 3 >( { i } ) != 0;
+        errors += mapping.getBlobByte< 3 >( { i } ) != 0;
+        errors += mapping.getBlobNr< 4 >( { i } ) != 1;
+        view( i )( st::Count() ) = std::int32_t( i );
+    }
+    view( 5u )( st::Weight() ) = 0.25f;
+    for ( std::size_t i = 0; i < elements; ++i )
+    {
+        errors += float( view( i )( st::Weight() ) ) != 0.25f;
+        errors += std::int32_t( view( i )( st::Count() ) )
+            != std::int32_t( i );
+    }
+    return report( "Uniform", errors );
+}
+
+/** checks the access counts of \ref llama::mapping::Heatmap and their CSV
+ *  and JSON output
+ */
+auto
+heatmap()
+-> std::size_t
+{
+    using Mapping = llama::mapping::Heatmap<
+        llama::mapping::SoA<
+            UD,
+            llama::DS<
+                llama::DE< st::Value, double >,
+                llama::DE< st::Count, std::int32_t >
+            >
+        >,
+        64
+    >;
+    // the values fill the first two lines, the counts the third one
+    Mapping const mapping( UD{ 16 } );
+    auto view = llama::Factory<
+        Mapping,
+        llama::allocator::Vector<>
+    >::allocView( mapping );
+    for ( std::size_t i = 0; i < 16; ++i )
+        view( i )( st::Value() ) = double( i );
+    std::int32_t count = view( 3u )( st::Count() );
+    count = view( 3u )( st::Count() );
+    static_cast< void >( count );
+    std::size_t errors = mapping.leafAccesses( 0 ) != 16;
+    errors += mapping.leafAccesses( 1 ) != 2;
+    errors += mapping.lineCount( 0 ) != 3;
+    errors += mapping.lineAccesses( 0, 0 ) != 8;
+    errors += mapping.lineAccesses( 0, 1 ) != 8;
+    errors += mapping.lineAccesses( 0, 2 ) != 2;
+    std::ostringstream csv;
+    mapping.writeCsv( csv );
+    errors += csv.str() != std::string(
+        "kind,leaf,blob,byte,accesses\n"
+        "leaf,0,,,16\n"
+        "leaf,1,,,2\n"
+        "line,,0,0,8\n"
+        "line,,0,64,8\n"
+        "line,,0,128,2\n"
+    );
+    std::ostringstream json;
+    mapping.writeJson( json );
+    errors += json.str() != std::string(
+        "{\n"
+        "  \"granularity\": 64,\n"
+        "  \"leaves\": [\n"
+        "    { \"coord\": [0], \"accesses\": 16 },\n"
+        "    { \"coord\": [1], \"accesses\": 2 }\n"
+        "  ],\n"
+        "  \"blobs\": [\n"
+        "    [8, 8, 2]\n"
+        "  ]\n"
+        "}\n"
+    );
+    mapping.reset();
+    errors += mapping.leafAccesses( 0 ) + mapping.lineAccesses( 0, 2 );
+    return report( "Heatmap", errors );
+}
+
+/// copies whole datums between views with 32 bit indices
+auto
+smallIndices()
+-> std::size_t
+{
+    using SmallUD = llama::UserDomain<
+        1,
+        std::uint32_t
+    >;
+    using Mapping = llama::mapping::SoA<
+        SmallUD,
+        Sample
+    >;
+    using Factory = llama::Factory<
+        Mapping,
+        llama::allocator::Vector<>
+    >;
+    static_assert(
+        std::is_same<
+            Mapping::IndexType,
+            std::uint32_t
+        >::value,
+        "The index type of the user domain should be kept"
+    );
+    Mapping const mapping( SmallUD{ std::uint32_t( elements ) } );
+    auto source = Factory::allocView( mapping );
+    auto destination = Factory::allocView( mapping );
+    for ( std::uint32_t i = 0; i < elements; ++i )
+    {
+        source( i )( st::Id() ) = std::uint16_t( i );
+        source( i )( st::Flag() ) = true;
+        source( i )( st::Value() ) = double( i ) / 2.0;
+        source( i )( st::Weight() ) = float( i );
+        source( i )( st::Count() ) = std::int32_t( i ) - 8;
+    }
+    for ( std::uint32_t i = 0; i < elements; ++i )
+        destination( i ) = source( i );
+    // a whole view as right hand side uses its first datum
+    auto first = destination( 1u );
+    first = source;
+    std::size_t errors = 0;
+    for ( std::uint32_t i = 2; i < elements; ++i )
+        errors += !( destination( i ) == source( i ) );
+    errors += !( destination( 1u ) == source( 0u ) );
+    errors += source( llama::DatumCoord< 2 >() ) != 0.0;
+    return report( "32 bit indices", errors );
+}
+
+int main()
+{
+    using llama::DatumCoord;
+    using llama::mapping::BitField;
+    using llama::mapping::StoredAs;
+    using llama::mapping::QuantizedAs;
+
+    std::size_t errors = 0;
+
+    errors += alignedAoS< llama::mapping::NaturalStride >(
+        "AlignedAoS",
+        24
+    );
+    errors += alignedAoS< llama::mapping::PowerOfTwoStride >(
+        "AlignedAoS power of two",
+        32
+    );
+    errors += alignedAoS< llama::mapping::MultipleOfStride< 64 > >(
+        "AlignedAoS cache line",
+        64
+    );
+
+    errors += alignedSoA< 64 >( "AlignedSoA" );
+    errors += alignedSoA< 256 >( "AlignedSoA padded" );
+
+    errors += reorder<
+        llama::mapping::KeepOrder,
+        boost::mp11::mp_list_c< std::size_t, 0, 1, 2, 3, 4 >
+    >( "Reorder keep", { 0, 2, 3, 11, 15 } );
+    errors += reorder<
+        llama::mapping::SortByAlignment,
+        boost::mp11::mp_list_c< std::size_t, 2, 3, 4, 0, 1 >
+    >( "Reorder alignment", { 16, 18, 0, 8, 12 } );
+    errors += reorder<
+        llama::mapping::Priority<
+            llama::DatumCoord< 4 >,
+            llama::DatumCoord< 1 >
+        >,
+        boost::mp11::mp_list_c< std::size_t, 4, 1, 0, 2, 3 >
+    >( "Reorder priority", { 5, 4, 7, 15, 0 } );
+
+    errors += split();
+
+    errors += bijective<
+        llama::LinearizeUserDomainAdressMorton< 2 >,
+        llama::ExtentUserDomainAdressMorton< 2 >
+    >( "Morton" );
+    errors += bijective<
+        llama::LinearizeUserDomainAdressHilbert< 2 >,
+        llama::ExtentUserDomainAdressHilbert< 2 >
+    >( "Hilbert" );
+    errors += bijective<
+        llama::LinearizeUserDomainAdressTiled< 2, 2, 2 >,
+        llama::ExtentUserDomainAdressTiled< 2, 2, 2 >
+    >( "Tiled" );
+    errors += bijective<
+        llama::LinearizeUserDomainAdressPitched<
+            2,
+            llama::FixedPitch< 2 >
+        >,
+        llama::ExtentUserDomainAdressPitched<
+            2,
+            llama::FixedPitch< 2 >
+        >
+    >( "Pitched" );
+    // rows of 3 elements are padded by 1
+    errors += bijective<
+        llama::LinearizeUserDomainAdressPitched<
+            2,
+            llama::AutoPitch< 3, 1 >
+        >,
+        llama::ExtentUserDomainAdressPitched<
+            2,
+            llama::AutoPitch< 3, 1 >
+        >
+    >( "Pitched auto" );
+    errors += bijective<
+        llama::LinearizeUserDomainAdressPeriodic< 2 >,
+        llama::ExtentUserDomainAdress< 2 >
+    >( "Periodic" );
+    errors += triangular< llama::UpperTriangle, true >( "Triangular" );
+    errors += triangular< llama::LowerTriangle, false >(
+        "Triangular lower without diagonal"
+    );
+
+    errors += sparseBlockGrid();
+
+    errors += computed();
+
+    errors += uniform();
+
+    errors += heatmap();
+
+    using Packed = llama::mapping::BitPack<
+        UD,
+        Sample,
+        boost::mp11::mp_list<
+            BitField< DatumCoord< 0 >, 11 >,
+            BitField< DatumCoord< 1 >, 1 >,
+            BitField< DatumCoord< 4 >, 14 >
+        >
+    >;
+    errors += roundTrip(
+        "BitPack",
+        Packed( UD{ elements } ),
+        1.0,
+        0.0,
+        0.0f
+    );
+
+    using Reduced = llama::mapping::ReducedPrecision<
+        UD,
+        Sample,
+        boost::mp11::mp_list<
+            StoredAs< DatumCoord< 2 >, float >,
+            StoredAs< DatumCoord< 3 >, llama::Half >
+        >,
+        llama::mapping::AoS
+    >;
+    // multiples of 1/64 in [0, 1) are exact as half
+    errors += roundTrip(
+        "ReducedPrecision",
+        Reduced( UD{ elements } ),
+        0.1,
+        1e-6,
+        0.0f
+    );
+
+    using Quantized = llama::mapping::Quantize<
+        UD,
+        Sample,
+        boost::mp11::mp_list<
+            QuantizedAs<
+                DatumCoord< 2 >,
+                std::int16_t,
+                std::ratio< -10 >,
+                std::ratio< 10 >
+            >,
+            QuantizedAs< DatumCoord< 3 >, std::uint8_t >
+        >
+    >;
+    errors += roundTrip(
+        "Quantize",
+        Quantized( UD{ elements } ),
+        0.3,
+        10.0 / 65535.0,
+        0.5f / 255.0f
+    );
+
+    using Swapped = llama::mapping::ByteSwap<
+        UD,
+        Sample
+    >;
+    errors += roundTrip(
+        "ByteSwap",
+        Swapped( UD{ elements } ),
+        1.0,
+        0.0,
+        0.0f
+    );
+    errors += byteSwapStorage();
+
+    errors += arrayAccess< llama::mapping::AoS< UD, Event > >( "AoS" );
+    errors += arrayAccess< llama::mapping::SoA< UD, Event > >( "SoA" );
+    errors += arrayAccess< AoSoA8< UD, Event > >( "AoSoA" );
+    errors += arrayAccess< llama::mapping::MultiBlobSoA< UD, Event > >(
+        "MultiBlobSoA"
+    );
+    errors += foldArray();
+    errors += smallIndices();
+
+    std::cout << ( errors == 0 ? "OK" : "FAILED" ) << '\n';
+    return errors == 0 ? 0 : 1;
+}
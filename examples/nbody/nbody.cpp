@@ -202,11 +202,12 @@ struct UpdateKernel
             treeOperationList
         );
 #else
+        using SharedUserDomain = llama::StaticUserDomain< blockSize >;
         using SharedMapping = llama::mapping::SoA<
-            typename decltype(particles)::Mapping::UserDomain,
+            SharedUserDomain,
             typename decltype(particles)::Mapping::DatumDomain
         >;
-        SharedMapping const sharedMapping( { blockSize } );
+        SharedMapping const sharedMapping{ SharedUserDomain{ } };
 #endif // NBODY_USE_SHARED_TREE
 
         using SharedFactory = llama::Factory<
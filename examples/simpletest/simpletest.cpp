@@ -84,6 +84,11 @@ int main(int argc,char * * argv)
         << llama::mapping::SoA< UD, Name >( udSize )
             .getBlobByte< 0, 1 >( { 0, 100 } )
         << std::endl;
+    std::cout
+        << "AoSoA address of (0,100) <0,1>: "
+        << llama::mapping::AoSoA< UD, Name, 8 >( udSize )
+            .getBlobByte< 0, 1 >( { 0, 100 } )
+        << std::endl;
     std::cout
         << "SizeOf DatumDomain: "
         << llama::SizeOf< Name >::value
@@ -155,6 +155,315 @@ struct SizeOf< DatumStruct< > >
 namespace internal
 {
 
+LLAMA_FN_HOST_ACC_INLINE
+constexpr
+auto
+roundUpToMultiple(
+    std::size_t const value,
+    std::size_t const multiple
+)
+-> std::size_t
+{
+    return ( value + multiple - 1 ) / multiple * multiple;
+}
+
+LLAMA_FN_HOST_ACC_INLINE
+constexpr
+auto
+nextPowerOfTwo(
+    std::size_t const value,
+    std::size_t const candidate = 1
+)
+-> std::size_t
+{
+    return candidate >= value ?
+        candidate :
+        nextPowerOfTwo( value, candidate * 2 );
+}
+
+} // namespace internal
+
+/** Gives the alignment a datum domain would have if it would be a normal
+ *  struct, which is the biggest alignment of all leaves
+ * \tparam T_DatumDomain datum domain tree
+ * \return the alignment as compile time value in "value"
+ */
+template< typename T_DatumDomain >
+struct AlignOf
+{
+    static constexpr std::size_t value = alignof( T_DatumDomain );
+};
+
+template<
+    typename T_FirstDatumElement,
+    typename... T_DatumElements
+>
+struct AlignOf<
+    DatumStruct<
+        T_FirstDatumElement,
+        T_DatumElements...
+    >
+>
+{
+    static constexpr std::size_t value =
+        AlignOf< GetDatumElementType< T_FirstDatumElement > >::value >
+        AlignOf< DatumStruct< T_DatumElements... > >::value ?
+            AlignOf< GetDatumElementType< T_FirstDatumElement > >::value :
+            AlignOf< DatumStruct< T_DatumElements... > >::value;
+};
+
+template< >
+struct AlignOf< DatumStruct< > >
+{
+    static constexpr std::size_t value = 1;
+};
+
+template< typename T_DatumDomain >
+struct AlignedSizeOf;
+
+namespace internal
+{
+
+template<
+    typename T_DatumDomain,
+    std::size_t T_offset
+>
+struct AlignedEndOfImpl;
+
+template<
+    std::size_t T_offset,
+    typename T_FirstDatumElement,
+    typename... T_DatumElements
+>
+struct AlignedEndOfImpl<
+    DatumStruct<
+        T_FirstDatumElement,
+        T_DatumElements...
+    >,
+    T_offset
+>
+{
+    static constexpr std::size_t value = AlignedEndOfImpl<
+        DatumStruct< T_DatumElements... >,
+        roundUpToMultiple(
+            T_offset,
+            AlignOf< GetDatumElementType< T_FirstDatumElement > >::value
+        )
+        + AlignedSizeOf< GetDatumElementType< T_FirstDatumElement > >::value
+    >::value;
+};
+
+template< std::size_t T_offset >
+struct AlignedEndOfImpl<
+    DatumStruct< >,
+    T_offset
+>
+{
+    static constexpr std::size_t value = T_offset;
+};
+
+template<
+    typename T_DatumDomain,
+    std::size_t T_offset,
+    std::size_t... T_coords
+>
+struct AlignedLinearBytePosImpl
+{
+    static constexpr std::size_t value = T_offset;
+};
+
+template<
+    typename T_DatumDomain,
+    std::size_t T_offset,
+    std::size_t T_firstCoord,
+    std::size_t... T_coords
+>
+struct AlignedLinearBytePosImpl<
+    T_DatumDomain,
+    T_offset,
+    T_firstCoord,
+    T_coords...
+>
+{
+    using Element = GetDatumElementType< boost::mp11::mp_at_c<
+        T_DatumDomain,
+        T_firstCoord
+    > >;
+    static constexpr std::size_t value = AlignedLinearBytePosImpl<
+        Element,
+        roundUpToMultiple(
+            AlignedEndOfImpl<
+                boost::mp11::mp_take_c<
+                    T_DatumDomain,
+                    T_firstCoord
+                >,
+                T_offset
+            >::value,
+            AlignOf< Element >::value
+        ),
+        T_coords...
+    >::value;
+};
+
+} // namespace internal
+
+/** Gives the size a datum domain would have if it would be a normal struct
+ *  including the padding needed for the natural alignment of every leaf
+ * \tparam T_DatumDomain datum domain tree
+ * \return the size as compile time value in "value"
+ * \see SizeOf
+ */
+template< typename T_DatumDomain >
+struct AlignedSizeOf
+{
+    static constexpr std::size_t value = sizeof( T_DatumDomain );
+};
+
+template< typename... T_DatumElements >
+struct AlignedSizeOf< DatumStruct< T_DatumElements... > >
+{
+    static constexpr std::size_t value = internal::roundUpToMultiple(
+        internal::AlignedEndOfImpl<
+            DatumStruct< T_DatumElements... >,
+            0
+        >::value,
+        AlignOf< DatumStruct< T_DatumElements... > >::value
+    );
+};
+
+/** Gives the byte position of an element in a datum domain if it would be a
+ *  normal struct including the padding needed for the natural alignment of
+ *  every leaf
+ * \tparam T_DatumDomain datum domain tree
+ * \tparam T_coords... coordinate in datum domain tree
+ * \return the byte position as compile time value in "value"
+ * \see LinearBytePos
+ */
+template<
+    typename T_DatumDomain,
+    std::size_t... T_coords
+>
+struct AlignedLinearBytePos
+{
+    static constexpr std::size_t value = internal::AlignedLinearBytePosImpl<
+        T_DatumDomain,
+        0,
+        T_coords...
+    >::value;
+};
+
+namespace internal
+{
+
+template<
+    typename T_DatumDomain,
+    typename T_IterCoord
+>
+struct FlatDatumCoordsImpl;
+
+template<
+    typename T_DatumDomain,
+    typename T_DatumCoord
+>
+struct FlatDatumCoordsNodeImpl
+{
+    using type = boost::mp11::mp_list< T_DatumCoord >;
+};
+
+template<
+    typename T_DatumCoord,
+    typename... T_DatumElements
+>
+struct FlatDatumCoordsNodeImpl<
+    DatumStruct< T_DatumElements... >,
+    T_DatumCoord
+>
+{
+    using type = typename FlatDatumCoordsImpl<
+        DatumStruct< T_DatumElements... >,
+        typename T_DatumCoord::template PushBack< 0 >
+    >::type;
+};
+
+template<
+    typename T_IterCoord,
+    typename T_FirstDatumElement,
+    typename... T_DatumElements
+>
+struct FlatDatumCoordsImpl<
+    DatumStruct<
+        T_FirstDatumElement,
+        T_DatumElements...
+    >,
+    T_IterCoord
+>
+{
+    using type = boost::mp11::mp_append<
+        typename FlatDatumCoordsNodeImpl<
+            GetDatumElementType< T_FirstDatumElement >,
+            T_IterCoord
+        >::type,
+        typename FlatDatumCoordsImpl<
+            DatumStruct< T_DatumElements... >,
+            typename T_IterCoord::IncBack
+        >::type
+    >;
+};
+
+template< typename T_IterCoord >
+struct FlatDatumCoordsImpl<
+    DatumStruct< >,
+    T_IterCoord
+>
+{
+    using type = boost::mp11::mp_list< >;
+};
+
+} // namespace internal
+
+/** Returns a compile time list (`boost::mp11::mp_list`) of the \ref DatumCoord
+ *  of every leaf of a datum domain in the same order as they would appear in a
+ *  normal struct.
+ * \tparam T_DatumDomain datum domain tree
+ */
+template< typename T_DatumDomain >
+using FlatDatumCoords = typename internal::FlatDatumCoordsImpl<
+    T_DatumDomain,
+    DatumCoord< 0 >
+>::type;
+
+/** Gives the number of leaves of a datum domain
+ * \tparam T_DatumDomain datum domain tree
+ * \return the number of leaves as compile time value in "value"
+ */
+template< typename T_DatumDomain >
+struct LeafCount
+{
+    static constexpr std::size_t value =
+        boost::mp11::mp_size< FlatDatumCoords< T_DatumDomain > >::value;
+};
+
+/** Gives the index of a leaf in a datum domain if all leaves would be
+ *  enumerated in the order of a normal struct
+ * \tparam T_DatumDomain datum domain tree
+ * \tparam T_coords... coordinate of a leaf in datum domain tree
+ * \return the leaf index as compile time value in "value"
+ */
+template<
+    typename T_DatumDomain,
+    std::size_t... T_coords
+>
+struct LinearLeafIndex
+{
+    static constexpr std::size_t value = boost::mp11::mp_find<
+        FlatDatumCoords< T_DatumDomain >,
+        DatumCoord< T_coords... >
+    >::value;
+};
+
+namespace internal
+{
+
 template< typename T_DatumDomain >
 struct StubTypeImpl
 {
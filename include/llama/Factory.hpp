@@ -91,7 +91,10 @@ makeBlobArray(
  *  the preferred way to create a \ref View.
  * \tparam T_Mapping Mapping type.
  *  A mapping binds the user domain and datum domain and needs to expose them as
- *  typedefs called `UserDomain` and `DatumDomain`. Furthermore it has to define
+ *  typedefs called `UserDomain` and `DatumDomain`. If the mapping is created
+ *  from another user domain size type like \ref StaticUserDomain, `UserDomain`
+ *  is still the coordinate type, see \ref UserDomainCoord, and the size type
+ *  is exposed as `UserDomainSize`. Furthermore it has to define
  *  a `static constexpr` called `blobCount` with the number of needed memory
  *  regions to allocate.
  *  Furthermore three methods need to be defined (Note: For
@@ -102,10 +105,37 @@ makeBlobArray(
  *    size in byte per blob
  *  - `template< std::size_t... > auto getBlobByte( UserDomain ) -> std::size_t`
  *    which returns the byte position for a given coordinate in the datum domain
- *    (template parameter) and user domain (method parameter).
+ *    (template parameter) and user domain (method parameter). Mappings may
+ *    return the index type of the user domain instead (see
+ *    \ref UserDomainIndexType), the \ref View checks on creation that every
+ *    blob can be addressed with it.
  *  - `template< std::size_t... > auto getBlobNr( UserDomain ) -> std::size_t`
  *    which returns the blob in which the byte position given by getBlobByte
  *    resides.
+ *
+ *  Leaves which can't be accessed with a normal reference, e.g. because they
+ *  are bit packed or converted, can be computed by the mapping on every
+ *  access instead. The mapping then defines
+ *  - `template< std::size_t... > using IsComputed` which is a boolean
+ *    integral constant for every coordinate in the datum domain telling
+ *    whether the leaf is computed and
+ *  - `template< std::size_t..., typename Blobs > auto compute( UserDomain,
+ *    Blobs & ) const` which returns the value or a proxy reference (see
+ *    \ref ProxyRefOpMixin) of a computed leaf, which the \ref View then
+ *    returns instead of a reference. Computed leaves can't be accessed with
+ *    \ref View::arrayAccessor.
+ *
+ *  Mappings placing the elements of a homogeneous \ref DatumArray at a
+ *  constant stride, like \ref mapping::AoS or \ref mapping::SoA, can define
+ *  - `template< std::size_t... A, std::size_t... E > auto getArrayBlobByte(
+ *    UserDomain, std::size_t, DatumCoord< A... >, DatumCoord< E... > )` and
+ *  - `template< std::size_t... A, std::size_t... E > auto getArrayBlobNr(
+ *    UserDomain, std::size_t, DatumCoord< A... >, DatumCoord< E... > )
+ *    -> std::size_t`
+ *
+ *  which return the byte position and blob of the leaf `E...` inside the
+ *  element with the given run time index of the array `A...`. Only then
+ *  \ref View::arrayAccessor can be used.
  * \tparam T_Allocator Allocator type, at default \ref allocator::Vector.
  *  An allocator also needs to define some typedefs, namely `PrimType` which
  *  is the raw datatype returned from the allocator (e.g. `unsigned char`),
@@ -125,7 +155,9 @@ template<
 >
 struct Factory
 {
-    /** Allocates the needed memory based in the mapping and returns a view
+    /** Allocates the needed memory based in the mapping and returns a view.
+     *  Every blob of the mapping needs to be addressable with the index type
+     *  of its user domain, which is only asserted.
      * \param mapping the mapping
      * \param allocatorParams optional allocator parameter, which may be
      *  forwarded to the allocator
@@ -140,4 +140,43 @@ using GetCoordFromUID = typename internal::GetCoordFromUIDImpl<
     T_UID...
 >::type;
 
+namespace internal
+{
+
+template<
+    typename T_DatumDomain,
+    typename... T_DatumCoordOrUIDs
+>
+struct ResolveDatumCoordImpl
+{
+    using type = GetCoordFromUID<
+        T_DatumDomain,
+        T_DatumCoordOrUIDs...
+    >;
+};
+
+template<
+    typename T_DatumDomain,
+    std::size_t... T_coords
+>
+struct ResolveDatumCoordImpl<
+    T_DatumDomain,
+    DatumCoord< T_coords... >
+>
+{
+    using type = DatumCoord< T_coords... >;
+};
+
+/// \ref DatumCoord of a coordinate given as UIDs **or** \ref DatumCoord
+template<
+    typename T_DatumDomain,
+    typename... T_DatumCoordOrUIDs
+>
+using ResolveDatumCoord = typename ResolveDatumCoordImpl<
+    T_DatumDomain,
+    T_DatumCoordOrUIDs...
+>::type;
+
+} // namespace internal
+
 } // namespace llama
@@ -0,0 +1,265 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined( __F16C__ ) && !defined( __CUDA_ARCH__ )
+#   include <immintrin.h>
+#   define LLAMA_HALF_F16C 1
+#endif
+
+#include "preprocessor/macros.hpp"
+
+namespace llama
+{
+
+namespace internal
+{
+
+LLAMA_FN_HOST_ACC_INLINE
+auto
+floatBits( float const value )
+-> std::uint32_t
+{
+    std::uint32_t bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    return bits;
+}
+
+LLAMA_FN_HOST_ACC_INLINE
+auto
+bitsFloat( std::uint32_t const bits )
+-> float
+{
+    float value;
+    std::memcpy( &value, &bits, sizeof( value ) );
+    return value;
+}
+
+} // namespace internal
+
+/** IEEE 754 half precision (binary16) storage type with 5 bit exponent and
+ *  10 bit mantissa, e.g. for \ref mapping::ReducedPrecision. It only converts
+ *  from and to `float` with rounding to nearest even, all arithmetic is done
+ *  after the conversion. The conversion uses the F16C instructions if they are
+ *  enabled (e.g. with `-mf16c` or `-march=native`), otherwise a branch free
+ *  implementation which compilers can vectorize.
+ */
+struct Half
+{
+    std::uint16_t bits;
+
+    Half() = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit Half( float const value ) :
+        bits( fromFloat( value ) )
+    { }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    operator float() const
+    {
+        return toFloat( bits );
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    fromFloat( float const value )
+    -> std::uint16_t
+    {
+#ifdef LLAMA_HALF_F16C
+        return _cvtss_sh( value, _MM_FROUND_TO_NEAREST_INT );
+#else
+        // rounds to nearest even, see F. Giesen, "float->half variants"
+        std::uint32_t const infinity = 255u << 23;
+        std::uint32_t const halfMax = ( 127u + 16u ) << 23;
+        std::uint32_t const denormMagic = ( ( 127u - 15u ) + ( 23u - 10u ) + 1u )
+            << 23;
+        std::uint32_t bits = internal::floatBits( value );
+        std::uint32_t const sign = bits & 0x80000000u;
+        bits ^= sign;
+        std::uint32_t const overflow = bits > infinity ? 0x7e00u : 0x7c00u;
+        std::uint32_t const denorm = internal::floatBits(
+            internal::bitsFloat( bits ) + internal::bitsFloat( denormMagic )
+        ) - denormMagic;
+        std::uint32_t const normal = ( bits + ( ( 15u - 127u ) << 23 ) + 0xfffu
+            + ( ( bits >> 13 ) & 1u ) ) >> 13;
+        std::uint32_t const result = bits >= halfMax ?
+            overflow :
+            ( bits < ( 113u << 23 ) ? denorm : normal );
+        return std::uint16_t( result | ( sign >> 16 ) );
+#endif
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    toFloat( std::uint16_t const bits )
+    -> float
+    {
+#ifdef LLAMA_HALF_F16C
+        return _cvtsh_ss( bits );
+#else
+        std::uint32_t const magic = 113u << 23;
+        std::uint32_t const shiftedExponent = 0x7c00u << 13;
+        std::uint32_t const exponentMantissa = ( bits & 0x7fffu ) << 13;
+        std::uint32_t const exponent = exponentMantissa & shiftedExponent;
+        std::uint32_t const rebiased =
+            exponentMantissa + ( ( 127u - 15u ) << 23 );
+        std::uint32_t const special = rebiased + ( ( 128u - 16u ) << 23 );
+        std::uint32_t const denorm = internal::floatBits(
+            internal::bitsFloat( rebiased + ( 1u << 23 ) )
+            - internal::bitsFloat( magic )
+        );
+        std::uint32_t const result = exponent == shiftedExponent ?
+            special :
+            ( exponent == 0 ? denorm : rebiased );
+        return internal::bitsFloat(
+            result | ( std::uint32_t( bits & 0x8000u ) << 16 )
+        );
+#endif
+    }
+};
+
+/** bfloat16 storage type, which is a `float` with the mantissa cut to 7 bits,
+ *  e.g. for \ref mapping::ReducedPrecision. It keeps the range of `float`
+ *  and converts with a shift and rounding to nearest even.
+ */
+struct BFloat16
+{
+    std::uint16_t bits;
+
+    BFloat16() = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit BFloat16( float const value ) :
+        bits( fromFloat( value ) )
+    { }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    operator float() const
+    {
+        return toFloat( bits );
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    fromFloat( float const value )
+    -> std::uint16_t
+    {
+        std::uint32_t const bits = internal::floatBits( value );
+        std::uint32_t const rounded =
+            ( bits + 0x7fffu + ( ( bits >> 16 ) & 1u ) ) >> 16;
+        // keeps NaN a (quiet) NaN instead of rounding it to infinity
+        return std::uint16_t(
+            ( bits & 0x7fffffffu ) > 0x7f800000u ?
+                ( bits >> 16 ) | 0x40u :
+                rounded
+        );
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    toFloat( std::uint16_t const bits )
+    -> float
+    {
+        return internal::bitsFloat( std::uint32_t( bits ) << 16 );
+    }
+};
+
+/** Converts an array of values element wise, e.g. a contiguous leaf of a
+ *  \ref mapping::ReducedPrecision with a \ref mapping::SoA inner mapping to
+ *  `float` and back. The loop has no dependencies between elements, so it can
+ *  be vectorized, for \ref Half to and from `float` explicitly with F16C if it
+ *  is enabled.
+ * \param source first of `count` values to convert
+ * \param destination first of `count` converted values
+ * \param count number of values
+ */
+template<
+    typename T_Source,
+    typename T_Destination
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+convertArray(
+    T_Source const * const source,
+    T_Destination * const destination,
+    std::size_t const count
+)
+-> void
+{
+    LLAMA_INDEPENDENT_DATA
+    for ( std::size_t i = 0; i < count; ++i )
+        destination[ i ] = static_cast< T_Destination >( source[ i ] );
+}
+
+#ifdef LLAMA_HALF_F16C
+
+inline
+auto
+convertArray(
+    Half const * const source,
+    float * const destination,
+    std::size_t const count
+)
+-> void
+{
+    std::size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 )
+        _mm256_storeu_ps(
+            destination + i,
+            _mm256_cvtph_ps( _mm_loadu_si128(
+                reinterpret_cast< __m128i const * >( source + i )
+            ) )
+        );
+    for ( ; i < count; ++i )
+        destination[ i ] = float( source[ i ] );
+}
+
+inline
+auto
+convertArray(
+    float const * const source,
+    Half * const destination,
+    std::size_t const count
+)
+-> void
+{
+    std::size_t i = 0;
+    for ( ; i + 8 <= count; i += 8 )
+        _mm_storeu_si128(
+            reinterpret_cast< __m128i * >( destination + i ),
+            _mm256_cvtps_ph(
+                _mm256_loadu_ps( source + i ),
+                _MM_FROUND_TO_NEAREST_INT
+            )
+        );
+    for ( ; i < count; ++i )
+        destination[ i ] = Half( source[ i ] );
+}
+
+#endif // LLAMA_HALF_F16C
+
+} // namespace llama
@@ -0,0 +1,146 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "preprocessor/macros.hpp"
+#include "DatumCoord.hpp"
+
+namespace llama
+{
+
+/** Base class for proxy references, which are returned by a \ref View instead
+ *  of a real reference for leaves a mapping computes on access (see
+ *  \ref Factory for the mapping interface), e.g. bit packed or converted
+ *  leaves. The proxy needs to define `operator ValueType() const` for reading,
+ *  `operator=( ValueType )` for writing and a copy assignment operator which
+ *  assigns the value and not the proxy itself. The compound assignment
+ *  operators are defined here on top of reading and writing. All other
+ *  operators work with the value after the implicit conversion.
+ * \tparam T_Derived type of the proxy reference itself (CRTP)
+ * \tparam T_ValueType type of the leaf as seen by the user
+ */
+template<
+    typename T_Derived,
+    typename T_ValueType
+>
+struct ProxyRefOpMixin
+{
+    /// type of the leaf as seen by the user
+    using ValueType = T_ValueType;
+
+#define __LLAMA_PROXYREF_COMPOUND_OPERATOR( OP, BINOP )                        \
+    template< typename T_Other >                                               \
+    LLAMA_FN_HOST_ACC_INLINE                                                   \
+    auto                                                                       \
+    operator OP( T_Other const & other )                                       \
+    -> T_Derived &                                                             \
+    {                                                                          \
+        T_Derived & derived = static_cast< T_Derived & >( *this );             \
+        derived = ValueType( ValueType( derived ) BINOP other );               \
+        return derived;                                                        \
+    }
+
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( +=  , +  )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( -=  , -  )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( *=  , *  )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( /=  , /  )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( %=  , %  )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( &=  , &  )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( |=  , |  )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( ^=  , ^  )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( <<= , << )
+    __LLAMA_PROXYREF_COMPOUND_OPERATOR( >>= , >> )
+
+#undef __LLAMA_PROXYREF_COMPOUND_OPERATOR
+};
+
+namespace internal
+{
+
+template< typename T >
+struct VoidIfType
+{
+    using type = void;
+};
+
+template<
+    typename T_Access,
+    typename T_SFinae = void
+>
+struct AccessValueTypeImpl
+{
+    using type = typename std::remove_reference< T_Access >::type;
+};
+
+template< typename T_Access >
+struct AccessValueTypeImpl<
+    T_Access,
+    typename VoidIfType< typename std::enable_if<
+        !std::is_reference< T_Access >::value,
+        typename T_Access::ValueType
+    >::type >::type
+>
+{
+    using type = typename T_Access::ValueType;
+};
+
+/** Type of the value behind the result of a leaf access, which is either a
+ *  reference or a proxy reference
+ */
+template< typename T_Access >
+using AccessValueType = typename AccessValueTypeImpl< T_Access >::type;
+
+/** Whether the result of a leaf access can be written, which is false for
+ *  read only proxy references like \ref mapping::ComputedRef
+ */
+template< typename T_Access >
+using IsWritableAccess = std::is_assignable<
+    T_Access,
+    AccessValueType< T_Access > const &
+>;
+
+/** Whether a mapping computes a leaf on access, i.e. whether it defines
+ *  `IsComputed` (see \ref Factory) and it is true for the leaf
+ */
+template<
+    typename T_Mapping,
+    typename T_DatumCoord,
+    typename T_SFinae = void
+>
+struct IsComputedLeaf : std::false_type {};
+
+template<
+    typename T_Mapping,
+    std::size_t... T_coords
+>
+struct IsComputedLeaf<
+    T_Mapping,
+    DatumCoord< T_coords... >,
+    typename VoidIfType<
+        typename T_Mapping::template IsComputed< T_coords... >
+    >::type
+> :
+    T_Mapping::template IsComputed< T_coords... >
+{};
+
+} // namespace internal
+
+} // namespace llama
@@ -32,13 +32,50 @@ struct NoName {};
 
 /** The run-time specified user domain
  * \tparam T_dim compile time dimensionality of the user domain
+ * \tparam T_IndexType type of the indices, which is also used by mappings
+ *  like \ref mapping::AoS or \ref mapping::SoA for the linearized user domain
+ *  and the byte offsets in the blobs. A 32 bit type like `std::uint32_t`
+ *  doubles the SIMD lanes of index vectors compared to the default
+ *  `std::size_t`, but limits the size of every blob to 4 GiB. It is a
+ *  precondition that every blob of the mapping can be addressed with this
+ *  type. As this is only checked by an assertion when the \ref View is
+ *  created, too big user domains silently wrap around in release builds.
  * */
-template< std::size_t T_dim >
+template<
+    std::size_t T_dim,
+    typename T_IndexType = std::size_t
+>
 using UserDomain = Array<
-    std::size_t,
+    T_IndexType,
     T_dim
 >;
 
+/** Compile time trait to get the index type of a user domain.
+ * \tparam T_UserDomain type of the user domain
+ * \return the index type in "type"
+ */
+template< typename T_UserDomain >
+struct UserDomainIndexTypeImpl;
+
+template<
+    typename T_IndexType,
+    std::size_t T_dim
+>
+struct UserDomainIndexTypeImpl<
+    Array<
+        T_IndexType,
+        T_dim
+    >
+>
+{
+    using type = T_IndexType;
+};
+
+/// Shortcut for \ref UserDomainIndexTypeImpl
+template< typename T_UserDomain >
+using UserDomainIndexType =
+    typename UserDomainIndexTypeImpl< T_UserDomain >::type;
+
 /** A list of \ref DatumElement which may be used to define a datum domain.
  * \tparam T_Leaves... List of \ref DatumElement
  * */
@@ -21,6 +21,9 @@
 #include "Types.hpp"
 #include "IntegerSequence.hpp"
 
+#include <limits>
+#include <type_traits>
+
 namespace llama
 {
 
@@ -29,12 +32,13 @@ template< std::size_t T_dim >
 struct ExtentUserDomainAdress
 {
     /**
-     * \param size user domain
+     * \param size user domain, e.g. \ref UserDomain or \ref StaticUserDomain
      * \return the calculated extent
      * */
+    template< typename T_UserDomainSize >
     LLAMA_FN_HOST_ACC_INLINE
     auto
-    operator()( UserDomain< T_dim > const & size ) const
+    operator()( T_UserDomainSize const & size ) const
     -> std::size_t
     {
         return ExtentUserDomainAdress< T_dim - 1 >()( size.pop_front() )
@@ -45,9 +49,10 @@ struct ExtentUserDomainAdress
 template< >
 struct ExtentUserDomainAdress< 1 >
 {
+    template< typename T_UserDomainSize >
     LLAMA_FN_HOST_ACC_INLINE
     auto
-    operator()( UserDomain< 1 > const & size ) const
+    operator()( T_UserDomainSize const & size ) const
     -> std::size_t
     {
         return size[ 0 ];
@@ -72,13 +77,20 @@ struct LinearizeUserDomainAdress
      * \param size total size of the user domain
      * \return linearized index
      * */
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
     LLAMA_FN_HOST_ACC_INLINE
     auto
     operator()(
-        UserDomain< T_dim > const & coord,
-        UserDomain< T_dim > const & size
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & size
     ) const
-    -> std::size_t
+    -> T_IndexType
     {
         return coord[ T_it - 1 ]
             + LinearizeUserDomainAdress<
@@ -88,7 +100,7 @@ struct LinearizeUserDomainAdress
                 coord,
                 size
             )
-            * size[ T_it - 1 ];
+            * T_IndexType( size[ T_it - 1 ] );
     }
 };
 
@@ -98,13 +110,20 @@ struct LinearizeUserDomainAdress<
     1
 >
 {
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
     LLAMA_FN_HOST_ACC_INLINE
     auto
     operator()(
-        UserDomain< T_dim > const & coord,
-        UserDomain< T_dim > const & size
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & size
     ) const
-    -> std::size_t
+    -> T_IndexType
     {
         return coord[ 0 ];
     }
@@ -124,33 +143,48 @@ struct LinearizeUserDomainAdressLikeFortran
      * \param coord coordinate in the user domain
      * \param size total size of the user domain
      * \return linearized index
-     * */    LLAMA_FN_HOST_ACC_INLINE
+     * */
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
+    LLAMA_FN_HOST_ACC_INLINE
     auto
     operator()(
-        UserDomain< T_dim > const & coord,
-        UserDomain< T_dim > const & size
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & size
     ) const
-    -> std::size_t
+    -> T_IndexType
     {
         return coord[ 0 ]
             + LinearizeUserDomainAdressLikeFortran< T_dim - 1 >()(
                 coord.pop_front(),
                 size.pop_front()
             )
-            * size[ 0 ];
+            * T_IndexType( size[ 0 ] );
     }
 };
 
 template< >
 struct LinearizeUserDomainAdressLikeFortran< 1 >
 {
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
     LLAMA_FN_HOST_ACC_INLINE
     auto
     operator()(
-        UserDomain< 1 > const & coord,
-        UserDomain< 1 > const & size
+        UserDomain<
+            1,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & size
     ) const
-    -> std::size_t
+    -> T_IndexType
     {
         return coord[ 0 ];
     }
@@ -159,30 +193,1061 @@ struct LinearizeUserDomainAdressLikeFortran< 1 >
 namespace internal
 {
 
+LLAMA_FN_HOST_ACC_INLINE
+auto
+bitsNeeded( std::size_t const size )
+-> std::size_t
+{
+    std::size_t bits = 0;
+    while ( ( std::size_t( 1 ) << bits ) < size )
+        ++bits;
+    return bits;
+}
+
+template< typename T_UserDomainSize >
+LLAMA_FN_HOST_ACC_INLINE
+auto
+maxBitsNeeded( T_UserDomainSize const & size )
+-> std::size_t
+{
+    std::size_t bits = 0;
+    for ( std::size_t i = 0; i < T_UserDomainSize::count; ++i )
+        if ( bitsNeeded( size[ i ] ) > bits )
+            bits = bitsNeeded( size[ i ] );
+    return bits;
+}
+
+template<
+    typename T_Functor,
+    typename T_UserDomainSize
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+makeLinearizer(
+    T_UserDomainSize const & /* size */,
+    std::false_type
+)
+-> T_Functor
+{
+    return T_Functor();
+}
+
+template<
+    typename T_Functor,
+    typename T_UserDomainSize
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+makeLinearizer(
+    T_UserDomainSize const & size,
+    std::true_type
+)
+-> T_Functor
+{
+    return T_Functor( size );
+}
+
+/** Creates the linearize functor of a mapping once for its user domain size.
+ *  Functors which precompute something of the size, e.g.
+ *  \ref LinearizeUserDomainAdressMorton, are constructed with it, all others
+ *  are default constructed.
+ */
+template<
+    typename T_Functor,
+    typename T_UserDomainSize
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+makeLinearizer( T_UserDomainSize const & size )
+-> T_Functor
+{
+    return makeLinearizer< T_Functor >(
+        size,
+        std::is_constructible<
+            T_Functor,
+            T_UserDomainSize const &
+        >()
+    );
+}
+
+} // namespace internal
+
+/** Functor that calculates the extent of a user domain linearized with
+ *  \ref LinearizeUserDomainAdressMorton, which is the product of the sizes
+ *  of all dimensions rounded up to the next power of two.
+ * \tparam T_dim dimension of the user domain
+ */
+template< std::size_t T_dim >
+struct ExtentUserDomainAdressMorton
+{
+    /**
+     * \param size user domain
+     * \return the calculated extent
+     * */
+    template< typename T_UserDomainSize >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()( T_UserDomainSize const & size ) const
+    -> std::size_t
+    {
+        std::size_t bits = 0;
+        for ( std::size_t i = 0; i < T_dim; ++i )
+            bits += internal::bitsNeeded( size[ i ] );
+        return std::size_t( 1 ) << bits;
+    }
+};
+
+/** Functor to get the linear position of a coordinate in the user domain space
+ *  along a Z-order (Morton) space filling curve. The bits of the coordinates
+ *  are interleaved with the last user domain index giving the lowest bit. If
+ *  a dimension runs out of bits (because it is smaller than others) it is
+ *  skipped, so non-cubic user domains only need their sizes rounded up to the
+ *  next power of two per dimension. Should be used together with
+ *  \ref ExtentUserDomainAdressMorton. The bits per dimension are counted when
+ *  the functor is constructed with the user domain size, which the mappings
+ *  do once, so it must not be default constructed for linearizing.
+ * \tparam T_dim dimension of the user domain
+ * \see LinearizeUserDomainAdressHilbert
+ * */
+template< std::size_t T_dim >
+struct LinearizeUserDomainAdressMorton
+{
+    LinearizeUserDomainAdressMorton() = default;
+
+    /// \param size total size of the user domain
+    template<
+        typename T_UserDomainSize,
+        typename = typename std::enable_if<
+            T_UserDomainSize::count == T_dim
+        >::type
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit
+    LinearizeUserDomainAdressMorton( T_UserDomainSize const & size ) :
+        maxBits( internal::maxBitsNeeded( size ) )
+    {
+        for ( std::size_t i = 0; i < T_dim; ++i )
+            bits[ i ] = internal::bitsNeeded( size[ i ] );
+    }
+
+    /**
+     * \param coord coordinate in the user domain
+     * \return linearized index
+     * */
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()(
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & /* size */
+    ) const
+    -> T_IndexType
+    {
+        T_IndexType result = 0;
+        std::size_t pos = 0;
+        for ( std::size_t bit = 0; bit < maxBits; ++bit )
+            for ( std::size_t i = T_dim; i-- > 0; )
+                if ( bit < bits[ i ] )
+                    result |= T_IndexType( ( coord[ i ] >> bit ) & 1 ) << pos++;
+        return result;
+    }
+
+    /// bits needed for every dimension
+    std::size_t bits[ T_dim ] = { };
+    /// bits needed for the biggest dimension
+    std::size_t maxBits = 0;
+};
+
+/** Functor that calculates the extent of a user domain linearized with
+ *  \ref LinearizeUserDomainAdressHilbert, which is a hyper cube with the
+ *  biggest size of all dimensions rounded up to the next power of two as edge
+ *  length.
+ * \tparam T_dim dimension of the user domain
+ */
+template< std::size_t T_dim >
+struct ExtentUserDomainAdressHilbert
+{
+    /**
+     * \param size user domain
+     * \return the calculated extent
+     * */
+    template< typename T_UserDomainSize >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()( T_UserDomainSize const & size ) const
+    -> std::size_t
+    {
+        return std::size_t( 1 ) << ( internal::maxBitsNeeded( size ) * T_dim );
+    }
+};
+
+/** Functor to get the linear position of a coordinate in the user domain space
+ *  along a Hilbert space filling curve (after J. Skilling, "Programming the
+ *  Hilbert curve", 2004). Unlike the Morton order neighboured indices are
+ *  always neighboured in the user domain, too, but the curve always covers a
+ *  hyper cube with a power of two edge length. Should be used together with
+ *  \ref ExtentUserDomainAdressHilbert. Like
+ *  \ref LinearizeUserDomainAdressMorton it needs to be constructed with the
+ *  user domain size.
+ * \tparam T_dim dimension of the user domain
+ * \see LinearizeUserDomainAdressMorton
+ * */
+template< std::size_t T_dim >
+struct LinearizeUserDomainAdressHilbert
+{
+    LinearizeUserDomainAdressHilbert() = default;
+
+    /// \param size total size of the user domain
+    template<
+        typename T_UserDomainSize,
+        typename = typename std::enable_if<
+            T_UserDomainSize::count == T_dim
+        >::type
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit
+    LinearizeUserDomainAdressHilbert( T_UserDomainSize const & size ) :
+        bits( internal::maxBitsNeeded( size ) )
+    { }
+
+    /**
+     * \param coord coordinate in the user domain
+     * \return linearized index
+     * */
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()(
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & /* size */
+    ) const
+    -> T_IndexType
+    {
+        if ( bits == 0 )
+            return 0;
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > x = coord;
+        std::size_t const m = std::size_t( 1 ) << ( bits - 1 );
+        // inverse undo
+        for ( std::size_t q = m; q > 1; q >>= 1 )
+        {
+            std::size_t const p = q - 1;
+            for ( std::size_t i = 0; i < T_dim; ++i )
+                if ( x[ i ] & q )
+                    x[ 0 ] ^= p;
+                else
+                {
+                    std::size_t const t = ( x[ 0 ] ^ x[ i ] ) & p;
+                    x[ 0 ] ^= t;
+                    x[ i ] ^= t;
+                }
+        }
+        // gray encode
+        for ( std::size_t i = 1; i < T_dim; ++i )
+            x[ i ] ^= x[ i - 1 ];
+        std::size_t t = 0;
+        for ( std::size_t q = m; q > 1; q >>= 1 )
+            if ( x[ T_dim - 1 ] & q )
+                t ^= q - 1;
+        for ( std::size_t i = 0; i < T_dim; ++i )
+            x[ i ] ^= t;
+        // interleave the transposed index, highest bit first
+        T_IndexType result = 0;
+        for ( std::size_t bit = bits; bit-- > 0; )
+            for ( std::size_t i = 0; i < T_dim; ++i )
+                result = ( result << 1 ) | ( ( x[ i ] >> bit ) & 1 );
+        return result;
+    }
+
+    /// bits needed for the biggest dimension, i.e. the edge of the hyper cube
+    std::size_t bits = 0;
+};
+
+/** Functor that calculates the extent of a user domain linearized with
+ *  \ref LinearizeUserDomainAdressTiled, which is the size of the user domain
+ *  with every dimension rounded up to a multiple of the tile size.
+ * \tparam T_dim dimension of the user domain
+ * \tparam T_tileExtents... compile time size of a tile in every dimension
+ */
+template<
+    std::size_t T_dim,
+    std::size_t... T_tileExtents
+>
+struct ExtentUserDomainAdressTiled
+{
+    static_assert(
+        sizeof...( T_tileExtents ) == T_dim,
+        "A tile extent is needed for every dimension"
+    );
+
+    /**
+     * \param size user domain
+     * \return the calculated extent
+     * */
+    template< typename T_UserDomainSize >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()( T_UserDomainSize const & size ) const
+    -> std::size_t
+    {
+        UserDomain< T_dim > const tile{ T_tileExtents... };
+        std::size_t result = 1;
+        for ( std::size_t i = 0; i < T_dim; ++i )
+            result *= ( size[ i ] + tile[ i ] - 1 ) / tile[ i ] * tile[ i ];
+        return result;
+    }
+};
+
+/** Functor to get the linear position of a coordinate in the user domain space
+ *  if the user domain is cut into tiles of a compile time size. The tiles are
+ *  stored one after another in C like order and the elements inside a tile in
+ *  C like order, too. Tiles at the border of the user domain are padded to the
+ *  full tile size. Should be used together with
+ *  \ref ExtentUserDomainAdressTiled.
+ * \tparam T_dim dimension of the user domain
+ * \tparam T_tileExtents... compile time size of a tile in every dimension,
+ *  best chosen as powers of two
+ * \see LinearizeUserDomainAdress
+ * */
+template<
+    std::size_t T_dim,
+    std::size_t... T_tileExtents
+>
+struct LinearizeUserDomainAdressTiled
+{
+    static_assert(
+        sizeof...( T_tileExtents ) == T_dim,
+        "A tile extent is needed for every dimension"
+    );
+
+    /**
+     * \param coord coordinate in the user domain
+     * \param size total size of the user domain
+     * \return linearized index
+     * */
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()(
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & size
+    ) const
+    -> T_IndexType
+    {
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const tile{ T_IndexType( T_tileExtents )... };
+        T_IndexType tileIndex = 0;
+        T_IndexType inTileIndex = 0;
+        T_IndexType tileVolume = 1;
+        for ( std::size_t i = 0; i < T_dim; ++i )
+        {
+            T_IndexType const tileCount =
+                ( T_IndexType( size[ i ] ) + tile[ i ] - 1 ) / tile[ i ];
+            tileIndex = tileIndex * tileCount + coord[ i ] / tile[ i ];
+            inTileIndex = inTileIndex * tile[ i ] + coord[ i ] % tile[ i ];
+            tileVolume *= tile[ i ];
+        }
+        return tileIndex * tileVolume + inTileIndex;
+    }
+};
+
+/** Pitch functor for \ref LinearizeUserDomainAdressPitched always adding a
+ *  fixed padding to every row (and plane, ...).
+ * \tparam T_padding padding in elements
+ */
+template< std::size_t T_padding >
+struct FixedPitch
+{
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    apply( std::size_t const extent )
+    -> std::size_t
+    {
+        return extent + T_padding;
+    }
+};
+
+/** Pitch functor for \ref LinearizeUserDomainAdressPitched adding a padding
+ *  only to rows (and planes, ...) whose extent is a multiple of a given
+ *  period, e.g. power of two grids. Rows of such a length map the same
+ *  element of neighboured rows to the same cache sets, which thrashes the
+ *  cache for column walks and multi-row stencils.
+ * \tparam T_aliasingPeriod extent in elements whose multiples get padded
+ * \tparam T_padding padding in elements, e.g. a cache line
+ */
+template<
+    std::size_t T_aliasingPeriod = 256u,
+    std::size_t T_padding = 16u
+>
+struct AutoPitch
+{
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    apply( std::size_t const extent )
+    -> std::size_t
+    {
+        return extent >= T_aliasingPeriod && extent % T_aliasingPeriod == 0 ?
+            extent + T_padding :
+            extent;
+    }
+};
+
+namespace internal
+{
+
+template<
+    typename T_PitchFunctor,
+    typename T_UserDomainSize
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+pitchedStrides( T_UserDomainSize const & size )
+-> UserDomain< T_UserDomainSize::count >
+{
+    UserDomain< T_UserDomainSize::count > strides;
+    strides[ T_UserDomainSize::count - 1 ] = 1;
+    for ( std::size_t i = T_UserDomainSize::count - 1; i > 0; --i )
+        strides[ i - 1 ] = T_PitchFunctor::apply( size[ i ] * strides[ i ] );
+    return strides;
+}
+
+} // namespace internal
+
+/** Functor that calculates the extent of a user domain linearized with
+ *  \ref LinearizeUserDomainAdressPitched, which is the size of the first
+ *  dimension times the pitch of the second one, so the padding of all rows
+ *  (and planes, ...) is part of the extent and of the blob sizes of the
+ *  mapping.
+ * \tparam T_dim dimension of the user domain
+ * \tparam T_PitchFunctor defines the pitch of a row (and plane, ...), see
+ *  \ref LinearizeUserDomainAdressPitched
+ */
+template<
+    std::size_t T_dim,
+    typename T_PitchFunctor = AutoPitch< >
+>
+struct ExtentUserDomainAdressPitched
+{
+    /**
+     * \param size user domain
+     * \return the calculated extent
+     * */
+    template< typename T_UserDomainSize >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()( T_UserDomainSize const & size ) const
+    -> std::size_t
+    {
+        return size[ 0 ]
+            * internal::pitchedStrides< T_PitchFunctor >( size )[ 0 ];
+    }
+};
+
+/** Functor to get the linear position of a coordinate in the user domain space
+ *  in C like order, but with padding after every row (last dimension) and
+ *  after every plane (last two dimensions) and so on, e.g. to avoid cache set
+ *  aliasing of power of two grids. The pitch of a dimension is gotten by
+ *  applying the pitch functor to the pitch of the next faster dimension times
+ *  its size. Should be used together with \ref ExtentUserDomainAdressPitched.
+ *  The pitches are calculated when the functor is constructed with the user
+ *  domain size, which the mappings do once.
+ * \tparam T_dim dimension of the user domain
+ * \tparam T_PitchFunctor Defines the pitch in elements of a row (and plane,
+ *  ...) for a given unpadded extent, e.g. only padding if the extent is a
+ *  multiple of a problematic period (\ref AutoPitch, default) or always
+ *  (\ref FixedPitch).
+ * \see LinearizeUserDomainAdress
+ * */
 template<
+    std::size_t T_dim,
+    typename T_PitchFunctor = AutoPitch< >
+>
+struct LinearizeUserDomainAdressPitched
+{
+    LinearizeUserDomainAdressPitched() = default;
+
+    /// \param size total size of the user domain
+    template<
+        typename T_UserDomainSize,
+        typename = typename std::enable_if<
+            T_UserDomainSize::count == T_dim
+        >::type
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit
+    LinearizeUserDomainAdressPitched( T_UserDomainSize const & size ) :
+        strides( internal::pitchedStrides< T_PitchFunctor >( size ) )
+    { }
+
+    /**
+     * \param coord coordinate in the user domain
+     * \return linearized index
+     * */
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()(
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & /* size */
+    ) const
+    -> T_IndexType
+    {
+        T_IndexType result = 0;
+        for ( std::size_t i = 0; i < T_dim; ++i )
+            result += coord[ i ] * T_IndexType( strides[ i ] );
+        return result;
+    }
+
+    /// distance in elements between neighbours of every dimension
+    UserDomain< T_dim > strides = { };
+};
+
+namespace internal
+{
+
+template< typename T_IndexType >
+LLAMA_FN_HOST_ACC_INLINE
+auto
+wrapCoord(
+    T_IndexType const coord,
+    T_IndexType const extent
+)
+-> T_IndexType
+{
+    using SignedIndexType = typename std::make_signed< T_IndexType >::type;
+    // fast path, also right for negative values in two's complement
+    if ( ( extent & ( extent - 1 ) ) == 0 )
+        return coord & ( extent - 1 );
+    SignedIndexType const wrapped =
+        SignedIndexType( coord ) % SignedIndexType( extent );
+    return T_IndexType(
+        wrapped < 0 ? wrapped + SignedIndexType( extent ) : wrapped
+    );
+}
+
+} // namespace internal
+
+/** Functor to get the linear position of a coordinate in the user domain space
+ *  in C like order, but with every coordinate wrapped around the extent of its
+ *  dimension first (periodic boundaries). Coordinates are interpreted as
+ *  signed, so e.g. `view( x - 1, y + 1 )` can be used without any branches or
+ *  clamping at the border, even for unsigned index types. Extents which are a
+ *  power of two use a bit mask instead of a modulo operation. Should be used
+ *  together with \ref ExtentUserDomainAdress.
+ * \tparam T_dim dimension of the user domain
+ * \see LinearizeUserDomainAdress
+ * */
+template< std::size_t T_dim >
+struct LinearizeUserDomainAdressPeriodic
+{
+    /**
+     * \param coord coordinate in the user domain, may be outside of it
+     * \param size total size of the user domain
+     * \return linearized index
+     * */
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()(
+        UserDomain<
+            T_dim,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & size
+    ) const
+    -> T_IndexType
+    {
+        T_IndexType result = 0;
+        for ( std::size_t i = 0; i < T_dim; ++i )
+        {
+            T_IndexType const extent = T_IndexType( size[ i ] );
+            result = result * extent
+                + internal::wrapCoord( coord[ i ], extent );
+        }
+        return result;
+    }
+};
+
+/// Tag for \ref LinearizeUserDomainAdressTriangular to store the upper triangle.
+struct UpperTriangle {};
+
+/// Tag for \ref LinearizeUserDomainAdressTriangular to store the lower triangle.
+struct LowerTriangle {};
+
+namespace internal
+{
+
+template<
+    typename T_Triangle,
+    bool T_withDiagonal
+>
+struct TriangularIndex;
+
+template< >
+struct TriangularIndex<
+    LowerTriangle,
+    true
+>
+{
+    template< typename T_IndexType >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    get(
+        T_IndexType const row,
+        T_IndexType const col,
+        T_IndexType const
+    )
+    -> T_IndexType
+    {
+        return row * ( row + 1 ) / 2 + col;
+    }
+};
+
+template< >
+struct TriangularIndex<
+    LowerTriangle,
+    false
+>
+{
+    template< typename T_IndexType >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    get(
+        T_IndexType const row,
+        T_IndexType const col,
+        T_IndexType const
+    )
+    -> T_IndexType
+    {
+        return row * ( row - 1 ) / 2 + col;
+    }
+};
+
+template< >
+struct TriangularIndex<
+    UpperTriangle,
+    true
+>
+{
+    template< typename T_IndexType >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    get(
+        T_IndexType const row,
+        T_IndexType const col,
+        T_IndexType const n
+    )
+    -> T_IndexType
+    {
+        return row * n - row * ( row - 1 ) / 2 + col - row;
+    }
+};
+
+template< >
+struct TriangularIndex<
+    UpperTriangle,
+    false
+>
+{
+    template< typename T_IndexType >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    get(
+        T_IndexType const row,
+        T_IndexType const col,
+        T_IndexType const n
+    )
+    -> T_IndexType
+    {
+        return row * ( n - 1 ) - row * ( row - 1 ) / 2 + col - row - 1;
+    }
+};
+
+} // namespace internal
+
+/** Functor that calculates the extent of a user domain linearized with
+ *  \ref LinearizeUserDomainAdressTriangular, which is the number of elements
+ *  of one triangle of the quadratic 2D user domain.
+ * \tparam T_withDiagonal whether the diagonal is stored, too
+ */
+template< bool T_withDiagonal = true >
+struct ExtentUserDomainAdressTriangular
+{
+    /**
+     * \param size user domain
+     * \return the calculated extent
+     * */
+    template< typename T_UserDomainSize >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()( T_UserDomainSize const & size ) const
+    -> std::size_t
+    {
+        return T_withDiagonal ?
+            size[ 0 ] * ( size[ 0 ] + 1 ) / 2 :
+            size[ 0 ] * ( size[ 0 ] - 1 ) / 2;
+    }
+};
+
+/** Functor to get the linear position of a coordinate in a quadratic 2D user
+ *  domain if only one triangle is stored row by row, e.g. for pairwise
+ *  interactions or symmetric matrices. Coordinates of the other triangle are
+ *  mirrored at the diagonal, so a symmetric matrix can be accessed with all
+ *  coordinates. Without the diagonal, coordinates on it must not be accessed.
+ *  Should be used together with \ref ExtentUserDomainAdressTriangular.
+ * \tparam T_Triangle the stored triangle, \ref UpperTriangle (default, the
+ *  second coordinate is not smaller than the first) or \ref LowerTriangle
+ * \tparam T_withDiagonal whether the diagonal is stored, too
+ * \see LinearizeUserDomainAdress
+ * */
+template<
+    typename T_Triangle = UpperTriangle,
+    bool T_withDiagonal = true
+>
+struct LinearizeUserDomainAdressTriangular
+{
+    /**
+     * \param coord coordinate in the user domain
+     * \param size total size of the user domain, only the first extent is
+     *  used
+     * \return linearized index
+     * */
+    template<
+        typename T_IndexType,
+        typename T_UserDomainSize
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()(
+        UserDomain<
+            2,
+            T_IndexType
+        > const & coord,
+        T_UserDomainSize const & size
+    ) const
+    -> T_IndexType
+    {
+        bool const swap = std::is_same<
+            T_Triangle,
+            UpperTriangle
+        >::value ?
+            coord[ 1 ] < coord[ 0 ] :
+            coord[ 0 ] < coord[ 1 ];
+        return internal::TriangularIndex<
+            T_Triangle,
+            T_withDiagonal
+        >::get(
+            swap ? coord[ 1 ] : coord[ 0 ],
+            swap ? coord[ 0 ] : coord[ 1 ],
+            T_IndexType( size[ 0 ] )
+        );
+    }
+};
+
+namespace internal
+{
+
+template<
+    typename T_IndexType,
     std::size_t... T_dims
 >
 LLAMA_FN_HOST_ACC_INLINE
 auto
 userDomainZeroHelper( IntegerSequence< T_dims... > )
--> UserDomain< sizeof...( T_dims ) >
+-> UserDomain<
+    sizeof...( T_dims ),
+    T_IndexType
+>
 {
-    return UserDomain< sizeof...( T_dims ) >{ T_dims... };
+    return UserDomain<
+        sizeof...( T_dims ),
+        T_IndexType
+    >{ T_IndexType( T_dims )... };
 }
 
 } // namespace internal
 
 /** Creates a user domain filled with zeros.
  * \tparam T_dim dimension of the user domain
+ * \tparam T_IndexType index type of the user domain, see \ref UserDomain
  * \return \ref UserDomain filled with zeros
  * */
-template< std::size_t T_dim >
+template<
+    std::size_t T_dim,
+    typename T_IndexType = std::size_t
+>
 LLAMA_FN_HOST_ACC_INLINE
 auto
 userDomainZero()
--> UserDomain< T_dim >
+-> UserDomain<
+    T_dim,
+    T_IndexType
+>
 {
-    return internal::userDomainZeroHelper( MakeZeroSequence< T_dim >{ } );
+    return internal::userDomainZeroHelper< T_IndexType >(
+        MakeZeroSequence< T_dim >{ }
+    );
 }
 
+/// Marks an extent of a \ref StaticUserDomain which is only known at run time.
+constexpr std::size_t dynamicExtent = std::numeric_limits< std::size_t >::max();
+
+template< std::size_t... T_extents >
+struct StaticUserDomain;
+
+namespace internal
+{
+
+template< std::size_t... T_extents >
+struct StaticExtentAt;
+
+template<
+    std::size_t T_first,
+    std::size_t... T_rest
+>
+struct StaticExtentAt<
+    T_first,
+    T_rest...
+>
+{
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    get( std::size_t const i )
+    -> std::size_t
+    {
+        return i == 0 ? T_first : StaticExtentAt< T_rest... >::get( i - 1 );
+    }
+};
+
+template< >
+struct StaticExtentAt< >
+{
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    get( std::size_t const )
+    -> std::size_t
+    {
+        return dynamicExtent;
+    }
+};
+
+template< std::size_t... T_extents >
+struct AllExtentsStatic
+{
+    static constexpr bool value = true;
+};
+
+template<
+    std::size_t T_first,
+    std::size_t... T_rest
+>
+struct AllExtentsStatic<
+    T_first,
+    T_rest...
+>
+{
+    static constexpr bool value = T_first != dynamicExtent
+        && AllExtentsStatic< T_rest... >::value;
+};
+
+template< typename T_StaticUserDomain >
+struct StaticUserDomainPopFront;
+
+template<
+    std::size_t T_first,
+    std::size_t... T_rest
+>
+struct StaticUserDomainPopFront< StaticUserDomain<
+    T_first,
+    T_rest...
+> >
+{
+    using type = StaticUserDomain< T_rest... >;
+};
+
+} // namespace internal
+
+/** User domain size with extents given as template parameters, which can be
+ *  used instead of \ref UserDomain as user domain type of all mappings and
+ *  with all extent and linearization functors. As the extents are compile time
+ *  constants, the compiler can fold the index calculations of a mapping to
+ *  constant strides, e.g. for small fixed grids or shared memory tiles.
+ *  Static and run time extents can be mixed by giving \ref dynamicExtent for
+ *  the run time ones. Coordinates in such a user domain are still given as
+ *  \ref UserDomain, see \ref UserDomainCoord. Its index type is always
+ *  `std::size_t`, smaller index types need a \ref UserDomain.
+ * \tparam T_extents... size of every dimension or \ref dynamicExtent
+ */
+template< std::size_t... T_extents >
+struct StaticUserDomain
+{
+    /// Number of dimensions
+    static constexpr std::size_t count = sizeof...( T_extents );
+
+    /// Creates a user domain size with all run time extents being zero.
+    LLAMA_FN_HOST_ACC_INLINE
+    StaticUserDomain( ) :
+        dynamicExtents( userDomainZero< count >() )
+    { }
+
+    /** \param size run time size of the user domain. The values given for
+     *  the static extents are ignored.
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    StaticUserDomain( UserDomain< count > const & size ) :
+        dynamicExtents( size )
+    { }
+
+    StaticUserDomain( StaticUserDomain const & ) = default;
+    StaticUserDomain( StaticUserDomain && ) = default;
+    ~StaticUserDomain( ) = default;
+
+    /** Checks whether an extent is known at compile time.
+     * \param idx dimension
+     * \return true if the extent of the dimension is static
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    isStatic( std::size_t const idx )
+    -> bool
+    {
+        return internal::StaticExtentAt< T_extents... >::get( idx )
+            != dynamicExtent;
+    }
+
+    /** Gives the extent of a dimension. Static extents are returned as
+     *  constant without touching the run time extents.
+     * \param idx dimension
+     * \return extent of the dimension
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    auto
+    operator[]( std::size_t const idx ) const
+    -> std::size_t
+    {
+        return isStatic( idx ) ?
+            internal::StaticExtentAt< T_extents... >::get( idx ) :
+            dynamicExtents[ idx ];
+    }
+
+    /** Returns a copy of the user domain size but with the first dimension
+     *  removed.
+     * \return StaticUserDomain with one dimension less
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    pop_front() const
+    -> typename internal::StaticUserDomainPopFront< StaticUserDomain >::type
+    {
+        return typename internal::StaticUserDomainPopFront<
+            StaticUserDomain
+        >::type( dynamicExtents.pop_front() );
+    }
+
+    /// Converts the user domain size to a run time \ref UserDomain.
+    LLAMA_FN_HOST_ACC_INLINE
+    operator UserDomain< count >() const
+    {
+        UserDomain< count > result( dynamicExtents );
+        for ( std::size_t i = 0; i < count; ++i )
+            result[ i ] = ( *this )[ i ];
+        return result;
+    }
+
+    /// Run time extents, only used for the dimensions not known statically.
+    UserDomain< count > dynamicExtents;
+};
+
+/** Compile time trait to get the type of a coordinate in a user domain, which
+ *  is \ref UserDomain for both \ref UserDomain and \ref StaticUserDomain.
+ *  Mappings define their `UserDomain` typedef with it.
+ * \tparam T_UserDomainSize type of the user domain size
+ */
+template< typename T_UserDomainSize >
+struct UserDomainCoordImpl
+{
+    using type = T_UserDomainSize;
+};
+
+template< std::size_t... T_extents >
+struct UserDomainCoordImpl< StaticUserDomain< T_extents... > >
+{
+    using type = UserDomain< sizeof...( T_extents ) >;
+};
+
+template< std::size_t... T_extents >
+struct UserDomainIndexTypeImpl< StaticUserDomain< T_extents... > >
+{
+    using type = std::size_t;
+};
+
+/// Shortcut for \ref UserDomainCoordImpl
+template< typename T_UserDomainSize >
+using UserDomainCoord = typename UserDomainCoordImpl< T_UserDomainSize >::type;
+
+/** Compile time trait checking whether all extents of a user domain size are
+ *  known at compile time.
+ * \tparam T_UserDomainSize type of the user domain size
+ * \return true or false as compile time value in "value"
+ */
+template< typename T_UserDomainSize >
+struct IsStaticUserDomain
+{
+    static constexpr bool value = false;
+};
+
+template< std::size_t... T_extents >
+struct IsStaticUserDomain< StaticUserDomain< T_extents... > >
+{
+    static constexpr bool value =
+        internal::AllExtentsStatic< T_extents... >::value;
+};
+
 } // namespace llama
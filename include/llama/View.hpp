@@ -20,12 +20,18 @@
 
 #include <boost/preprocessor/cat.hpp>
 #include <type_traits>
+#include <utility>
+#include <limits>
+#include <cassert>
 
 #include "preprocessor/macros.hpp"
 #include "GetType.hpp"
+#include "GetCoordFromUID.hpp"
 #include "Array.hpp"
+#include "UserDomain.hpp"
 #include "ForEach.hpp"
 #include "CompareUID.hpp"
+#include "Proxy.hpp"
 
 namespace llama
 {
@@ -41,13 +47,52 @@ struct View;
  *  In the first case the operation is applied if the unique id of the two
  *  elements in the datum domain is the same, in the second case the operation
  *  is applied to every combination of elements of the virtual datum and the
- *  second type.
+ *  second type. Leaves which can't be written, like computed leaves of
+ *  \ref mapping::Computed, are skipped.
  * \param OP operation, e.g. +=
  * \param FUNCTOR operation naming used for functor name definition, e.g. if
  *        FUNCTOR is "Addition", the functors will be named AdditionFunctor
  *        and AdditionTypeFunctor.
  * */
 #define __LLAMA_DEFINE_FOREACH_FUNCTOR( OP, FUNCTOR )                          \
+    template< bool T_writable >                                                \
+    struct BOOST_PP_CAT( FUNCTOR, LeafFunctor)                                 \
+    {                                                                          \
+        template<                                                              \
+            typename T_Left,                                                   \
+            typename T_Right                                                   \
+        >                                                                      \
+        LLAMA_FN_HOST_ACC_INLINE                                               \
+        static                                                                 \
+        auto                                                                   \
+        apply(                                                                 \
+            T_Left && left,                                                    \
+            T_Right const & right                                              \
+        )                                                                      \
+        -> void                                                                \
+        {                                                                      \
+            left OP right;                                                     \
+        }                                                                      \
+    };                                                                         \
+                                                                               \
+    template< >                                                                \
+    struct BOOST_PP_CAT( FUNCTOR, LeafFunctor)< false >                        \
+    {                                                                          \
+        template<                                                              \
+            typename T_Left,                                                   \
+            typename T_Right                                                   \
+        >                                                                      \
+        LLAMA_FN_HOST_ACC_INLINE                                               \
+        static                                                                 \
+        auto                                                                   \
+        apply(                                                                 \
+            T_Left &&,                                                         \
+            T_Right const &                                                    \
+        )                                                                      \
+        -> void                                                                \
+        { }                                                                    \
+    };                                                                         \
+                                                                               \
     template<                                                                  \
         typename T_LeftDatum,                                                  \
         typename T_LeftBase,                                                   \
@@ -103,7 +148,14 @@ struct View;
         {                                                                      \
             using Dst = typename T_LeftBase::template Cat< T_LeftLocal >;      \
             using Src = typename T_RightBase::template Cat< T_RightLocal >;    \
-            left( Dst() ) OP right( Src() );                                   \
+            BOOST_PP_CAT( FUNCTOR, LeafFunctor)<                               \
+                internal::IsWritableAccess<                                    \
+                    decltype( left( Dst() ) )                                  \
+                >::value                                                       \
+            >::apply(                                                          \
+                left( Dst() ),                                                 \
+                right( Src() )                                                 \
+            );                                                                 \
         }                                                                      \
         T_LeftDatum & left;                                                    \
         T_RightDatum & right;                                                  \
@@ -202,8 +254,16 @@ struct View;
         -> void                                                                \
         {                                                                      \
             using Dst = typename T_OuterCoord::template Cat< T_InnerCoord >;   \
-            left( Dst() ) OP static_cast< typename std::remove_reference<      \
-                decltype( left( Dst() ) ) >::type >( right );                  \
+            BOOST_PP_CAT( FUNCTOR, LeafFunctor)<                               \
+                internal::IsWritableAccess<                                    \
+                    decltype( left( Dst() ) )                                  \
+                >::value                                                       \
+            >::apply(                                                          \
+                left( Dst() ),                                                 \
+                static_cast<                                                   \
+                    internal::AccessValueType< decltype( left( Dst() ) ) >     \
+                >( right )                                                     \
+            );                                                                 \
         }                                                                      \
         T_LeftDatum & left;                                                    \
         T_RightType & right;                                                   \
@@ -272,8 +332,10 @@ __LLAMA_DEFINE_FOREACH_FUNCTOR( %= , Modulo )
     )                                                                          \
     -> decltype(*this)&                                                        \
     {                                                                          \
-        auto otherVd =                                                         \
-            other( userDomainZero< T_OtherMapping::UserDomain::count >() );    \
+        auto otherVd = other( userDomainZero<                                  \
+            T_OtherMapping::UserDomain::count,                                 \
+            UserDomainIndexType< typename T_OtherMapping::UserDomain >         \
+        >() );                                                                 \
         BOOST_PP_CAT( FUNCTOR, Functor)<                                       \
             decltype(*this),                                                   \
             decltype(otherVd),                                                 \
@@ -506,8 +568,9 @@ __LLAMA_DEFINE_FOREACH_FUNCTOR( %= , Modulo )
         {                                                                      \
             using Dst = typename T_OuterCoord::template Cat< T_InnerCoord >;   \
             result &=                                                          \
-                left( Dst() ) OP static_cast< typename std::remove_reference<  \
-                decltype( left( Dst() ) ) >::type >( right );                  \
+                left( Dst() ) OP static_cast<                                  \
+                    internal::AccessValueType< decltype( left( Dst() ) ) >     \
+                >( right );                                                    \
         }                                                                      \
         T_LeftDatum & left;                                                    \
         T_RightType & right;                                                   \
@@ -582,8 +645,10 @@ __LLAMA_DEFINE_FOREACH_BOOL_FUNCTOR( >= , BiggerSameThan )
     )                                                                          \
     -> bool                                                                    \
     {                                                                          \
-        auto otherVd =                                                         \
-            other( userDomainZero< T_OtherMapping::UserDomain::count >() );    \
+        auto otherVd = other( userDomainZero<                                  \
+            T_OtherMapping::UserDomain::count,                                 \
+            UserDomainIndexType< typename T_OtherMapping::UserDomain >         \
+        >() );                                                                 \
         BOOST_PP_CAT( FUNCTOR, BoolFunctor)<                                   \
             decltype(*this),                                                   \
             decltype(otherVd),                                                 \
@@ -640,6 +705,17 @@ __LLAMA_DEFINE_FOREACH_BOOL_FUNCTOR( >= , BiggerSameThan )
     __LLAMA_VIRTUALDATUM_TYPE_BOOL_OPERATOR( OP, FUNCTOR, & )                  \
     __LLAMA_VIRTUALDATUM_TYPE_BOOL_OPERATOR( OP, FUNCTOR, && )
 
+namespace internal
+{
+    template<
+        typename T_ArrayCoord,
+        std::size_t T_index,
+        typename T_ElementCoord
+    >
+    using ArrayElementDatumCoord = typename T_ArrayCoord::template
+        PushBack< T_index >::template Cat< T_ElementCoord >;
+} // namespace internal
+
 /** Virtual data type returned by \ref View after resolving user domain address,
  *  being "virtual" in that sense that the data of the virtual datum are not
  *  part of the struct itself but a helper object to address them in the compile
@@ -672,7 +748,7 @@ struct VirtualDatum
             T_View&& view,
             T_UserDomain const & userDomainPos
         )
-        -> decltype( view.template accessor< T_UIDs... >( userDomainPos ) )&
+        -> decltype( view.template accessor< T_UIDs... >( userDomainPos ) )
         {
             LLAMA_FORCE_INLINE_RECURSIVE
             return view.template accessor< T_UIDs... >( userDomainPos );
@@ -690,7 +766,7 @@ struct VirtualDatum
             T_View&& view,
             T_UserDomain const & userDomainPos
         )
-        -> decltype( view.template accessor< T_coord... >( userDomainPos ) )&
+        -> decltype( view.template accessor< T_coord... >( userDomainPos ) )
         {
             LLAMA_FORCE_INLINE_RECURSIVE
             return view.template accessor< T_coord... >( userDomainPos );
@@ -704,7 +780,7 @@ struct VirtualDatum
     -> decltype( AccessImpl< T_DatumCoordOrUIDs... >::apply(
             std::forward<T_View>(view),
             userDomainPos
-        ) ) &
+        ) )
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return AccessImpl< T_DatumCoordOrUIDs... >::apply(
@@ -728,7 +804,7 @@ struct VirtualDatum
     -> decltype( AccessImpl< T_DatumCoordOrUIDs... >::apply(
             std::forward<T_View>(view),
             userDomainPos
-        ) ) &
+        ) )
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return AccessImpl< T_DatumCoordOrUIDs... >::apply(
@@ -751,7 +827,7 @@ struct VirtualDatum
     -> decltype( AccessImpl< DatumCoord< T_coord... > >::apply(
             std::forward<T_View>(view),
             userDomainPos
-        ) ) &
+        ) )
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return AccessImpl< DatumCoord< T_coord... > >::apply(
@@ -760,6 +836,72 @@ struct VirtualDatum
         );
     }
 
+    /** Access function for an element of a \ref DatumArray with an index
+     *  given at run time, so loops over the elements don't need to be
+     *  unrolled. See \ref View::arrayAccessor.
+     * \tparam T_DatumCoordOrUIDs... variadic number of types as unique
+     *  identifier **or** \ref DatumCoord of the array
+     * \param index index of the element in the array
+     * \return reference to element at resolved user domain and given array
+     *  index
+     */
+    template< typename... T_DatumCoordOrUIDs >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    at( std::size_t const index )
+    -> decltype( view.template arrayAccessor<
+            internal::ResolveDatumCoord<
+                typename Mapping::DatumDomain,
+                T_DatumCoordOrUIDs...
+            >
+        >( userDomainPos, index ) )
+    {
+        LLAMA_FORCE_INLINE_RECURSIVE
+        return view.template arrayAccessor<
+            internal::ResolveDatumCoord<
+                typename Mapping::DatumDomain,
+                T_DatumCoordOrUIDs...
+            >
+        >( userDomainPos, index );
+    }
+
+    /** Access function for a leaf inside an element of a \ref DatumArray
+     *  of \ref DatumStruct with an index given at run time. See
+     *  \ref View::arrayAccessor.
+     * \tparam T_DatumCoordOrUIDs... variadic number of types as unique
+     *  identifier **or** \ref DatumCoord of the array
+     * \param index index of the element in the array
+     * \param elementCoord \ref DatumCoord of the leaf inside the element
+     * \return reference to leaf at resolved user domain and given array index
+     */
+    template<
+        typename... T_DatumCoordOrUIDs,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    at(
+        std::size_t const index,
+        DatumCoord< T_elementCoord... > LLAMA_IGNORE_LITERAL( elementCoord )
+    )
+    -> decltype( view.template arrayAccessor<
+            internal::ResolveDatumCoord<
+                typename Mapping::DatumDomain,
+                T_DatumCoordOrUIDs...
+            >,
+            DatumCoord< T_elementCoord... >
+        >( userDomainPos, index ) )
+    {
+        LLAMA_FORCE_INLINE_RECURSIVE
+        return view.template arrayAccessor<
+            internal::ResolveDatumCoord<
+                typename Mapping::DatumDomain,
+                T_DatumCoordOrUIDs...
+            >,
+            DatumCoord< T_elementCoord... >
+        >( userDomainPos, index );
+    }
+
     /** operator overload() for a coordinate in the datum domain given as
      *  unique identifier or \ref DatumCoord.
      * \param datumCoordOrUIDs instantiation of variadic number of unique
@@ -773,12 +915,12 @@ struct VirtualDatum
     auto
     operator()( T_DatumCoordOrUIDs&&... LLAMA_IGNORE_LITERAL( datumCoordOrUIDs ) )
 #if !BOOST_COMP_INTEL && !BOOST_COMP_NVCC
-    -> decltype( access< T_DatumCoordOrUIDs... >() ) &
+    -> decltype( access< T_DatumCoordOrUIDs... >() )
 #else //Intel compiler bug work around
     -> decltype( AccessImpl< T_DatumCoordOrUIDs... >::apply(
         std::forward<T_View>(view),
         userDomainPos
-    ) ) &
+    ) )
 #endif
     {
         LLAMA_FORCE_INLINE_RECURSIVE
@@ -842,6 +984,120 @@ namespace internal
             return mapping.template getBlobByte< T_coords... >( userDomain );
         }
     };
+
+    template<
+        typename T_DatumCoord,
+        bool T_computed
+    >
+    struct LeafAccess;
+
+    template< std::size_t... T_coords >
+    struct LeafAccess<
+        DatumCoord< T_coords... >,
+        false
+    >
+    {
+        template< typename T_View >
+        LLAMA_NO_HOST_ACC_WARNING
+        static auto
+        LLAMA_FN_HOST_ACC_INLINE
+        get(
+            T_View & view,
+            typename T_View::Mapping::UserDomain const userDomain
+        )
+        -> GetType<
+            typename T_View::Mapping::DatumDomain,
+            T_coords...
+        > &
+        {
+            auto const nr =
+                view.mapping.template getBlobNr< T_coords... >( userDomain );
+            auto const byte =
+                view.mapping.template getBlobByte< T_coords... >( userDomain );
+            return *( reinterpret_cast< GetType<
+                    typename T_View::Mapping::DatumDomain,
+                    T_coords...
+                >* > (
+                    &view.blob[ nr ][ byte ]
+                )
+            );
+        }
+    };
+
+    template< std::size_t... T_coords >
+    struct LeafAccess<
+        DatumCoord< T_coords... >,
+        true
+    >
+    {
+        template< typename T_View >
+        LLAMA_NO_HOST_ACC_WARNING
+        static auto
+        LLAMA_FN_HOST_ACC_INLINE
+        get(
+            T_View & view,
+            typename T_View::Mapping::UserDomain const userDomain
+        )
+        -> decltype( view.mapping.template compute< T_coords... >(
+            userDomain,
+            view.blob
+        ) )
+        {
+            LLAMA_FORCE_INLINE_RECURSIVE
+            return view.mapping.template compute< T_coords... >(
+                userDomain,
+                view.blob
+            );
+        }
+    };
+
+    /** Whether a mapping can give the position of an element of a
+     *  \ref DatumArray with a run time index, i.e. whether it defines
+     *  `getArrayBlobNr` and `getArrayBlobByte` (see \ref Factory)
+     */
+    template<
+        typename T_Mapping,
+        typename T_ArrayCoord,
+        typename T_ElementCoord,
+        typename T_SFinae = void
+    >
+    struct HasArrayAccess : std::false_type {};
+
+    template<
+        typename T_Mapping,
+        typename T_ArrayCoord,
+        typename T_ElementCoord
+    >
+    struct HasArrayAccess<
+        T_Mapping,
+        T_ArrayCoord,
+        T_ElementCoord,
+        typename VoidIfType< decltype(
+            std::declval< T_Mapping const & >().getArrayBlobByte(
+                std::declval< typename T_Mapping::UserDomain >(),
+                std::size_t( 0 ),
+                T_ArrayCoord(),
+                T_ElementCoord()
+            ) + std::declval< T_Mapping const & >().getArrayBlobNr(
+                std::declval< typename T_Mapping::UserDomain >(),
+                std::size_t( 0 ),
+                T_ArrayCoord(),
+                T_ElementCoord()
+            )
+        ) >::type
+    > : std::true_type {};
+
+    template<
+        typename T_Mapping,
+        typename T_DatumCoord
+    >
+    using MappingLeafAccess = LeafAccess<
+        T_DatumCoord,
+        IsComputedLeaf<
+            T_Mapping,
+            T_DatumCoord
+        >::value
+    >;
 }; //namespace internal
 
 /** Central LLAMA class holding memory and giving access to it defined by a
@@ -860,6 +1116,8 @@ struct View
     using BlobType = T_BlobType;
     /// used mapping
     using Mapping = T_Mapping;
+    /// index type of the user domain of the mapping
+    using IndexType = UserDomainIndexType< typename Mapping::UserDomain >;
     /** corresponding \ref llama::VirtualDatum type returned after resolving user
      *  domain
      */
@@ -886,7 +1144,16 @@ struct View
     ) :
         mapping( mapping ),
         blob( blob )
-    { }
+    {
+        for ( std::size_t i = 0; i < Mapping::blobCount; ++i )
+            assert(
+                ( mapping.getBlobSize( i ) == 0 ||
+                    mapping.getBlobSize( i ) - 1 <= std::size_t(
+                        std::numeric_limits< IndexType >::max()
+                    ) )
+                && "Blob too big to be addressed with the index type"
+            );
+    }
 
     /** Explicit access function taking the datum domain as tree index
      *  coordinate template arguments and the user domain as runtime parameter.
@@ -894,30 +1161,25 @@ struct View
      *  array of struct like interface using \ref llama::VirtualDatum.
      * \tparam T_coords... tree index coordinate
      * \param userDomain user domain as \ref UserDomain
-     * \return reference to element
+     * \return reference to element or for leaves computed by the mapping
+     *  whatever the mapping returns, usually a proxy reference derived from
+     *  \ref ProxyRefOpMixin
      */
     LLAMA_NO_HOST_ACC_WARNING
     template< std::size_t... T_coords >
     LLAMA_FN_HOST_ACC_INLINE
     auto
     accessor( typename Mapping::UserDomain const userDomain )
-    -> GetType<
-        typename Mapping::DatumDomain,
-        T_coords...
-    > &
+    -> decltype( internal::MappingLeafAccess<
+            Mapping,
+            DatumCoord< T_coords... >
+        >::get( *this, userDomain ) )
     {
-
-        auto const nr =
-            mapping.template getBlobNr< T_coords... >( userDomain );
-        auto const byte =
-            mapping.template getBlobByte< T_coords... >( userDomain );
-        return *( reinterpret_cast< GetType<
-                typename Mapping::DatumDomain,
-                T_coords...
-            >* > (
-                &blob[ nr ][ byte ]
-            )
-        );
+        LLAMA_FORCE_INLINE_RECURSIVE
+        return internal::MappingLeafAccess<
+            Mapping,
+            DatumCoord< T_coords... >
+        >::get( *this, userDomain );
     }
 
     /** Explicit access function taking the datum domain as UID type list
@@ -926,40 +1188,126 @@ struct View
      *  array of struct like interface using \ref llama::VirtualDatum.
      * \tparam T_UIDs... UID type list
      * \param userDomain user domain as \ref UserDomain
-     * \return reference to element
+     * \return reference to element or for leaves computed by the mapping
+     *  whatever the mapping returns, usually a proxy reference derived from
+     *  \ref ProxyRefOpMixin
      */
     LLAMA_NO_HOST_ACC_WARNING
     template< typename... T_UIDs >
     LLAMA_FN_HOST_ACC_INLINE
     auto
     accessor( typename Mapping::UserDomain const userDomain )
+    -> decltype( internal::MappingLeafAccess<
+            Mapping,
+            GetCoordFromUID<
+                typename Mapping::DatumDomain,
+                T_UIDs...
+            >
+        >::get( *this, userDomain ) )
+    {
+        LLAMA_FORCE_INLINE_RECURSIVE
+        return internal::MappingLeafAccess<
+            Mapping,
+            GetCoordFromUID<
+                typename Mapping::DatumDomain,
+                T_UIDs...
+            >
+        >::get( *this, userDomain );
+    }
+
+    /** Explicit access function for an element of a homogeneous
+     *  \ref DatumArray with an index given at run time. The mapping gives the
+     *  blob and byte of the element with `getArrayBlobNr` and
+     *  `getArrayBlobByte` (see \ref Factory), which for most mappings is a
+     *  multiply-add with a constant stride, so loops over the elements can
+     *  stay rolled and be vectorized. Mappings which don't place the elements
+     *  at a constant stride don't define these functions and are rejected at
+     *  compile time, as are leaves computed by the mapping.
+     * \tparam T_ArrayCoord \ref DatumCoord of the array
+     * \tparam T_ElementCoord \ref DatumCoord of the leaf inside an array
+     *  element, empty if the elements are leaves
+     * \param userDomain user domain as \ref UserDomain
+     * \param index index of the element in the array
+     * \return reference to element
+     */
+    LLAMA_NO_HOST_ACC_WARNING
+    template<
+        typename T_ArrayCoord,
+        typename T_ElementCoord = DatumCoord< >
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    arrayAccessor(
+        typename Mapping::UserDomain const userDomain,
+        std::size_t const index
+    )
     -> GetTypeFromDatumCoord<
         typename Mapping::DatumDomain,
-        GetCoordFromUID<
-            typename Mapping::DatumDomain,
-            T_UIDs...
+        internal::ArrayElementDatumCoord<
+            T_ArrayCoord,
+            0,
+            T_ElementCoord
         >
     > &
     {
-        using DatumCoord = GetCoordFromUID<
+        using ArrayType = GetTypeFromDatumCoord<
             typename Mapping::DatumDomain,
-            T_UIDs...
+            T_ArrayCoord
         >;
-        auto const nr =
-            internal::MappingDatumCoordCaller< DatumCoord >::getBlobNr(
-                mapping,
-                userDomain
-            );
-        auto const byte =
-            internal::MappingDatumCoordCaller< DatumCoord >::getBlobByte(
-                mapping,
-                userDomain
-            );
+        static_assert(
+            boost::mp11::mp_apply<
+                boost::mp11::mp_same,
+                boost::mp11::mp_push_front<
+                    ArrayType,
+                    boost::mp11::mp_first< ArrayType >
+                >
+            >::value,
+            "Only a DatumArray with identical elements can be indexed at run "
+            "time"
+        );
+        static_assert(
+            !internal::IsComputedLeaf<
+                Mapping,
+                internal::ArrayElementDatumCoord<
+                    T_ArrayCoord,
+                    0,
+                    T_ElementCoord
+                >
+            >::value,
+            "Leaves computed by the mapping can't be indexed at run time"
+        );
+        static_assert(
+            internal::HasArrayAccess<
+                Mapping,
+                T_ArrayCoord,
+                T_ElementCoord
+            >::value,
+            "The mapping does not support run time array indices as it does "
+            "not place the array elements at a constant stride"
+        );
+        assert(
+            index < boost::mp11::mp_size< ArrayType >::value &&
+            "Array index out of range"
+        );
         return *( reinterpret_cast< GetTypeFromDatumCoord<
                 typename Mapping::DatumDomain,
-                DatumCoord
+                internal::ArrayElementDatumCoord<
+                    T_ArrayCoord,
+                    0,
+                    T_ElementCoord
+                >
             >* > (
-                &blob[ nr ][ byte ]
+                &blob[ mapping.getArrayBlobNr(
+                    userDomain,
+                    index,
+                    T_ArrayCoord(),
+                    T_ElementCoord()
+                ) ][ mapping.getArrayBlobByte(
+                    userDomain,
+                    index,
+                    T_ArrayCoord(),
+                    T_ElementCoord()
+                ) ]
             )
         );
     }
@@ -990,7 +1338,7 @@ struct View
      *  (\ref llama::VirtualDatum). Should be favoured to access data because of the
      *  more array of struct like interface and the handy intermediate
      *  \ref llama::VirtualDatum object.
-     * \tparam T_Coord... types of user domain coordinates
+     * \tparam T_Coord... integral types of user domain coordinates
      * \param coord user domain as list of numbers
      * \return \ref llama::VirtualDatum with bound user domain, which can be used to
      *  access the datum domain
@@ -999,11 +1347,17 @@ struct View
     LLAMA_FN_HOST_ACC_INLINE
     auto
     operator()( T_Coord... coord )
-    -> VirtualDatumType
+    -> typename std::enable_if<
+        boost::mp11::mp_all_of<
+            boost::mp11::mp_list< T_Coord... >,
+            std::is_integral
+        >::value,
+        VirtualDatumType
+    >::type
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return VirtualDatumType{
-                typename Mapping::UserDomain{ coord... },
+                typename Mapping::UserDomain{ IndexType( coord )... },
                 *this
             };
     }
@@ -1012,11 +1366,17 @@ struct View
     LLAMA_FN_HOST_ACC_INLINE
     auto
     operator()( T_Coord... coord ) const
-    -> const VirtualDatumType
+    -> typename std::enable_if<
+        boost::mp11::mp_all_of<
+            boost::mp11::mp_list< T_Coord... >,
+            std::is_integral
+        >::value,
+        const VirtualDatumType
+    >::type
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return VirtualDatumType{
-                typename Mapping::UserDomain{ coord... },
+                typename Mapping::UserDomain{ IndexType( coord )... },
                 *this
             };
     }
@@ -1028,7 +1388,7 @@ struct View
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return VirtualDatumType{
-                typename Mapping::UserDomain{ coord },
+                typename Mapping::UserDomain{ IndexType( coord ) },
                 *this
             };
     }
@@ -1037,15 +1397,16 @@ struct View
     LLAMA_FN_HOST_ACC_INLINE
     auto
     operator()( DatumCoord< T_coord... > && dc= DatumCoord< T_coord... >() )
-    -> GetType<
-        typename Mapping::DatumDomain,
-        T_coord...
-    > &
+    -> decltype( accessor< T_coord... >( userDomainZero<
+        Mapping::UserDomain::count,
+        IndexType
+    >() ) )
     {
         LLAMA_FORCE_INLINE_RECURSIVE
-        return accessor< T_coord... >(
-            userDomainZero< Mapping::UserDomain::count >()
-        );
+        return accessor< T_coord... >( userDomainZero<
+            Mapping::UserDomain::count,
+            IndexType
+        >() );
     }
 
     /// mapping of the view
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <utility>
+
 #include "preprocessor/macros.hpp"
 #include "View.hpp"
 
@@ -40,6 +42,8 @@ struct VirtualView
     using BlobType = typename ParentView::BlobType;
     /// mapping type, gotten from parent view
     using Mapping = typename ParentView::Mapping;
+    /// index type of the user domain, gotten from parent view
+    using IndexType = typename ParentView::IndexType;
     /// VirtualDatum type, gotten from parent view
     using VirtualDatumType = typename ParentView::VirtualDatumType;
 
@@ -82,10 +86,9 @@ struct VirtualView
     LLAMA_FN_HOST_ACC_INLINE
     auto
     accessor( typename Mapping::UserDomain const userDomain )
-    -> GetType<
-        typename Mapping::DatumDomain,
+    -> decltype( std::declval< ParentView & >().template accessor<
         T_coords...
-    > &
+    >( userDomain ) )
     {
         return parentView.template accessor< T_coords... >(
             userDomain + position
@@ -105,16 +108,50 @@ struct VirtualView
     LLAMA_FN_HOST_ACC_INLINE
     auto
     accessor( typename Mapping::UserDomain const userDomain )
+    -> decltype( std::declval< ParentView & >().template accessor<
+        T_UIDs...
+    >( userDomain ) )
+    {
+        return parentView.template accessor< T_UIDs... >(
+            userDomain + position
+        );
+    }
+
+    /** Explicit access function for an element of a \ref DatumArray with an
+     *  index given at run time, see \ref View::arrayAccessor.
+     * \tparam T_ArrayCoord \ref DatumCoord of the array
+     * \tparam T_ElementCoord \ref DatumCoord of the leaf inside an array
+     *  element, empty if the elements are leaves
+     * \param userDomain user domain as \ref UserDomain
+     * \param index index of the element in the array
+     * \return reference to element
+     */
+    LLAMA_NO_HOST_ACC_WARNING
+    template<
+        typename T_ArrayCoord,
+        typename T_ElementCoord = DatumCoord< >
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    arrayAccessor(
+        typename Mapping::UserDomain const userDomain,
+        std::size_t const index
+    )
     -> GetTypeFromDatumCoord<
         typename Mapping::DatumDomain,
-        GetCoordFromUID<
-            typename Mapping::DatumDomain,
-            T_UIDs...
+        internal::ArrayElementDatumCoord<
+            T_ArrayCoord,
+            0,
+            T_ElementCoord
         >
     > &
     {
-        return parentView.template accessor< T_UIDs... >(
-            userDomain + position
+        return parentView.template arrayAccessor<
+            T_ArrayCoord,
+            T_ElementCoord
+        >(
+            userDomain + position,
+            index
         );
     }
 
@@ -154,7 +191,7 @@ struct VirtualView
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return parentView(
-            typename Mapping::UserDomain{ coord... } + position
+            typename Mapping::UserDomain{ IndexType( coord )... } + position
         );
     }
 
@@ -166,7 +203,7 @@ struct VirtualView
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return parentView(
-            typename Mapping::UserDomain{ coord... } + position
+            typename Mapping::UserDomain{ IndexType( coord )... } + position
         );
     }
 
@@ -177,7 +214,7 @@ struct VirtualView
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return parentView(
-            typename Mapping::UserDomain{ coord } + position
+            typename Mapping::UserDomain{ IndexType( coord ) } + position
         );
     }
 
@@ -185,10 +222,9 @@ struct VirtualView
     LLAMA_FN_HOST_ACC_INLINE
     auto
     operator()( DatumCoord< T_coord... > && dc= DatumCoord< T_coord... >() )
-    -> GetType<
-        typename Mapping::DatumDomain,
+    -> decltype( std::declval< ParentView & >().template accessor<
         T_coord...
-    > &
+    >( userDomainZero< Mapping::UserDomain::count >() ) )
     {
         LLAMA_FORCE_INLINE_RECURSIVE
         return accessor< T_coord... >(
@@ -60,8 +60,25 @@
 #include "Factory.hpp"
 
 #include "mapping/AoS.hpp"
+#include "mapping/AlignedAoS.hpp"
 #include "mapping/SoA.hpp"
+#include "mapping/AlignedSoA.hpp"
+#include "mapping/AoSoA.hpp"
+#include "mapping/MultiBlobSoA.hpp"
 #include "mapping/One.hpp"
+#include "mapping/Reorder.hpp"
+#include "mapping/Split.hpp"
+#include "mapping/Halo.hpp"
+#include "mapping/SparseBlockGrid.hpp"
+#include "mapping/Ragged.hpp"
+#include "mapping/FoldArray.hpp"
+#include "mapping/BitPack.hpp"
+#include "mapping/ReducedPrecision.hpp"
+#include "mapping/Quantize.hpp"
+#include "mapping/ByteSwap.hpp"
+#include "mapping/Computed.hpp"
+#include "mapping/Uniform.hpp"
+#include "mapping/Heatmap.hpp"
 #include "mapping/tree/Mapping.hpp"
 
 #include "preprocessor/macros.hpp"
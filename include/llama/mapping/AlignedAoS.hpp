@@ -0,0 +1,172 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../Types.hpp"
+#include "../DatumStruct.hpp"
+#include "../UserDomain.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/// Stride functor for \ref AlignedAoS keeping the naturally aligned size.
+struct NaturalStride
+{
+    static
+    constexpr
+    auto
+    apply( std::size_t const size )
+    -> std::size_t
+    {
+        return size;
+    }
+};
+
+/** Stride functor for \ref AlignedAoS rounding the size up to the next power
+ *  of two. Records not bigger than a cache line never straddle two cache
+ *  lines then.
+ */
+struct PowerOfTwoStride
+{
+    static
+    constexpr
+    auto
+    apply( std::size_t const size )
+    -> std::size_t
+    {
+        return llama::internal::nextPowerOfTwo( size );
+    }
+};
+
+/** Stride functor for \ref AlignedAoS rounding the size up to a multiple of
+ *  a given alignment, e.g. the cache line size.
+ * \tparam T_alignment alignment in byte the stride is rounded up to
+ */
+template< std::size_t T_alignment = 64u >
+struct MultipleOfStride
+{
+    static
+    constexpr
+    auto
+    apply( std::size_t const size )
+    -> std::size_t
+    {
+        return llama::internal::roundUpToMultiple( size, T_alignment );
+    }
+};
+
+/** Array of struct mapping which can be used for creating a \ref View with a
+ *  \ref Factory. For the interface details see \ref Factory. Unlike \ref AoS
+ *  the leaves of the datum domain are padded like a normal C struct, so every
+ *  leaf is naturally aligned if the blob is aligned to \ref AlignOf of the
+ *  datum domain.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_StrideFunctor Defines how the naturally aligned size of the datum
+ *  domain is rounded up to the distance of two datums in memory, e.g. not at
+ *  all (\ref NaturalStride, default), to the next power of two
+ *  (\ref PowerOfTwoStride) or to a multiple of the cache line size
+ *  (\ref MultipleOfStride).
+ * \tparam T_LinearizeUserDomainAdressFunctor Defines how the user domain should
+ *  be linearized, e.g. C like with the last dimension being the "fast" one
+ *  (\ref LinearizeUserDomainAdress, default) or Fortran like with the first
+ *  dimension being the "fast" one (\ref LinearizeUserDomainAdressLikeFortran).
+ * \tparam T_ExtentUserDomainAdressFunctor Defines how the size of the view
+ *  shall be created. Should fit for `T_LinearizeUserDomainAdressFunctor`. Only
+ *  right now implemented and default value is \ref ExtentUserDomainAdress.
+ * \see AoS
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_StrideFunctor = NaturalStride,
+    typename T_LinearizeUserDomainAdressFunctor =
+        LinearizeUserDomainAdress< T_UserDomain::count >,
+    typename T_ExtentUserDomainAdressFunctor =
+        ExtentUserDomainAdress< T_UserDomain::count >
+>
+struct AlignedAoS
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    static constexpr std::size_t blobCount = 1;
+    /// distance of two datums in memory
+    static constexpr std::size_t stride =
+        T_StrideFunctor::apply( AlignedSizeOf< DatumDomain >::value );
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    AlignedAoS( UserDomainSize const size ) :
+        userDomainSize( size ),
+        linearizeUserDomainAdress( llama::internal::makeLinearizer<
+            T_LinearizeUserDomainAdressFunctor
+        >( size ) )
+    { }
+
+    AlignedAoS() = default;
+    AlignedAoS( AlignedAoS const & ) = default;
+    AlignedAoS( AlignedAoS && ) = default;
+    ~AlignedAoS( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const ) const
+    -> std::size_t
+    {
+        return T_ExtentUserDomainAdressFunctor()(userDomainSize) * stride;
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return linearizeUserDomainAdress(
+                coord,
+                userDomainSize
+            )
+            * IndexType( stride )
+            + IndexType( AlignedLinearBytePos<
+                DatumDomain,
+                T_datumDomainCoord...
+            >::value );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return 0;
+    }
+    UserDomainSize const userDomainSize;
+    T_LinearizeUserDomainAdressFunctor const linearizeUserDomainAdress;
+};
+
+} // namespace mapping
+
+} // namespace llama
@@ -0,0 +1,166 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Compile time trait giving the alignment in byte every array of a leaf of
+ *  the datum domain is guaranteed to start at inside its blob. Kernels may
+ *  assume aligned loads for this alignment if the blob itself is allocated
+ *  with at least the same alignment. Mappings without such a guarantee give
+ *  1.
+ * \tparam T_Mapping mapping to get the alignment of
+ * \return the alignment as compile time value in "value"
+ */
+template< typename T_Mapping >
+struct FieldAlignment
+{
+    static constexpr std::size_t value = 1;
+};
+
+/** Struct of array mapping which can be used for creating a \ref View with a
+ *  \ref Factory. For the interface details see \ref Factory. Unlike \ref SoA
+ *  the extent of the user domain is rounded up to a multiple of `T_alignment`
+ *  so that the array of every leaf starts at a multiple of `T_alignment`
+ *  bytes. This costs at most `T_alignment - 1` padding elements per leaf.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_alignment alignment in byte of the array of every leaf, e.g. the
+ *  cache line size or the SIMD register width. The blob should be allocated
+ *  with at least this alignment, too.
+ * \tparam T_LinearizeUserDomainAdressFunctor Defines how the user domain should
+ *  be linearized, e.g. C like with the last dimension being the "fast" one
+ *  (\ref LinearizeUserDomainAdress, default) or Fortran like with the first
+ *  dimension being the "fast" one (\ref LinearizeUserDomainAdressLikeFortran).
+ * \tparam T_ExtentUserDomainAdressFunctor Defines how the size of the view
+ *  shall be created. Should fit for `T_LinearizeUserDomainAdressFunctor`. Only
+ *  right now implemented and default value is \ref ExtentUserDomainAdress.
+ * \see SoA, FieldAlignment
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    std::size_t T_alignment = 64u,
+    typename T_LinearizeUserDomainAdressFunctor =
+        LinearizeUserDomainAdress< T_UserDomain::count >,
+    typename T_ExtentUserDomainAdressFunctor =
+        ExtentUserDomainAdress< T_UserDomain::count >
+>
+struct AlignedSoA
+{
+    static_assert( T_alignment > 0, "Alignment needs to be at least 1" );
+
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    static constexpr std::size_t blobCount = 1;
+    /// alignment in byte of the array of every leaf
+    static constexpr std::size_t alignment = T_alignment;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    AlignedSoA( UserDomainSize const size ) :
+        userDomainSize( size ),
+        linearizeUserDomainAdress( llama::internal::makeLinearizer<
+            T_LinearizeUserDomainAdressFunctor
+        >( size ) ),
+        extentUserDomainAdress( llama::internal::roundUpToMultiple(
+            T_ExtentUserDomainAdressFunctor()( userDomainSize ),
+            alignment
+        ) )
+    {}
+
+    AlignedSoA() = default;
+    AlignedSoA( AlignedSoA const & ) = default;
+    AlignedSoA( AlignedSoA && ) = default;
+    ~AlignedSoA( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const ) const
+    -> std::size_t
+    {
+        return extentUserDomainAdress * SizeOf<DatumDomain>::value;
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return linearizeUserDomainAdress( coord, userDomainSize )
+            * IndexType( sizeof( GetType<
+                DatumDomain,
+                T_datumDomainCoord...
+            > ) )
+            + IndexType( LinearBytePos<
+                DatumDomain,
+                T_datumDomainCoord...
+            >::value )
+            * IndexType( extentUserDomainAdress );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return 0;
+    }
+    UserDomainSize const userDomainSize;
+    T_LinearizeUserDomainAdressFunctor const linearizeUserDomainAdress;
+    /// extent of the user domain rounded up to a multiple of the alignment
+    std::size_t const extentUserDomainAdress;
+};
+
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    std::size_t T_alignment,
+    typename T_LinearizeUserDomainAdressFunctor,
+    typename T_ExtentUserDomainAdressFunctor
+>
+struct FieldAlignment<
+    AlignedSoA<
+        T_UserDomain,
+        T_DatumDomain,
+        T_alignment,
+        T_LinearizeUserDomainAdressFunctor,
+        T_ExtentUserDomainAdressFunctor
+    >
+>
+{
+    static constexpr std::size_t value = T_alignment;
+};
+
+} // namespace mapping
+
+} // namespace llama
@@ -0,0 +1,190 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Array of struct of arrays mapping which can be used for creating a
+ *  \ref View with a \ref Factory. For the interface details see \ref Factory.
+ *  The linearized user domain is cut into blocks of `T_lanes` datums. Inside
+ *  such a block the datum domain is stored like in \ref SoA, the blocks
+ *  themselves are stored one after another like in \ref AoS. The last block
+ *  is padded if the extent of the user domain is not a multiple of `T_lanes`.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_lanes number of datums per block, best chosen as (a multiple of)
+ *  the SIMD width of the target architecture
+ * \tparam T_LinearizeUserDomainAdressFunctor Defines how the user domain should
+ *  be linearized, e.g. C like with the last dimension being the "fast" one
+ *  (\ref LinearizeUserDomainAdress, default) or Fortran like with the first
+ *  dimension being the "fast" one (\ref LinearizeUserDomainAdressLikeFortran).
+ * \tparam T_ExtentUserDomainAdressFunctor Defines how the size of the view
+ *  shall be created. Should fit for `T_LinearizeUserDomainAdressFunctor`. Only
+ *  right now implemented and default value is \ref ExtentUserDomainAdress.
+ * \see AoS, SoA
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    std::size_t T_lanes,
+    typename T_LinearizeUserDomainAdressFunctor =
+        LinearizeUserDomainAdress< T_UserDomain::count >,
+    typename T_ExtentUserDomainAdressFunctor =
+        ExtentUserDomainAdress< T_UserDomain::count >
+>
+struct AoSoA
+{
+    static_assert( T_lanes > 0, "AoSoA needs at least one lane per block" );
+
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    static constexpr std::size_t blobCount = 1;
+    /// number of datums stored field by field in one block
+    static constexpr std::size_t lanes = T_lanes;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    AoSoA( UserDomainSize const size ) :
+        userDomainSize( size ),
+        linearizeUserDomainAdress( llama::internal::makeLinearizer<
+            T_LinearizeUserDomainAdressFunctor
+        >( size ) ),
+        extentUserDomainAdress(
+            T_ExtentUserDomainAdressFunctor()( userDomainSize )
+        )
+    { }
+
+    AoSoA() = default;
+    AoSoA( AoSoA const & ) = default;
+    AoSoA( AoSoA && ) = default;
+    ~AoSoA( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const ) const
+    -> std::size_t
+    {
+        return ( extentUserDomainAdress + lanes - 1 ) / lanes
+            * lanes
+            * SizeOf<DatumDomain>::value;
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        IndexType const linearIndex =
+            linearizeUserDomainAdress( coord, userDomainSize );
+        IndexType const blockIndex = linearIndex / IndexType( lanes );
+        IndexType const laneIndex = linearIndex % IndexType( lanes );
+        return blockIndex * IndexType( lanes * SizeOf<DatumDomain>::value )
+            + IndexType( LinearBytePos<
+                DatumDomain,
+                T_datumDomainCoord...
+            >::value
+            * lanes )
+            + laneIndex
+            * IndexType( sizeof( GetType<
+                DatumDomain,
+                T_datumDomainCoord...
+            > ) );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return 0;
+    }
+
+    /** Gives the byte position of a leaf in an element of a homogeneous
+     *  \ref DatumArray with the element index given at run time, see
+     *  \ref View::arrayAccessor. The elements are at a constant stride of the
+     *  element size times the number of lanes.
+     * \param coord coordinate in the user domain
+     * \param index index of the element in the array
+     * \return byte position of the leaf
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getArrayBlobByte(
+        UserDomain const coord,
+        std::size_t const index,
+        DatumCoord< T_arrayCoord... >,
+        DatumCoord< T_elementCoord... >
+    ) const
+    -> IndexType
+    {
+        return getBlobByte< T_arrayCoord..., 0, T_elementCoord... >( coord )
+            + IndexType( index ) * IndexType( SizeOf< GetType<
+                DatumDomain,
+                T_arrayCoord...,
+                0
+            > >::value * lanes );
+    }
+
+    /** Gives the blob of a leaf in an element of a homogeneous
+     *  \ref DatumArray with the element index given at run time, see
+     *  \ref View::arrayAccessor. All leaves are in the only blob.
+     * \return blob of the leaf
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    auto
+    getArrayBlobNr(
+        UserDomain const /* coord */,
+        std::size_t const /* index */,
+        DatumCoord< T_arrayCoord... >,
+        DatumCoord< T_elementCoord... >
+    ) const
+    -> std::size_t
+    {
+        return 0;
+    }
+    UserDomainSize const userDomainSize;
+    T_LinearizeUserDomainAdressFunctor const linearizeUserDomainAdress;
+    std::size_t const extentUserDomainAdress;
+};
+
+} // namespace mapping
+
+} // namespace llama
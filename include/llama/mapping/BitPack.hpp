@@ -0,0 +1,574 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+#include "../Proxy.hpp"
+#include "Reorder.hpp"
+#include "SoA.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Declares the bit width of an integral or boolean leaf (or of all leaves of
+ *  a branch) for \ref BitPack.
+ * \tparam T_DatumCoord \ref DatumCoord of the leaf or branch, e.g. gotten with
+ *  \ref GetCoordFromUID
+ * \tparam T_bits number of bits stored per value, at most 57
+ */
+template<
+    typename T_DatumCoord,
+    std::size_t T_bits
+>
+struct BitField
+{
+    using DatumCoord = T_DatumCoord;
+    static constexpr std::size_t bits = T_bits;
+};
+
+/** Proxy reference to a value of \ref BitPack. Reading and writing loads and
+ *  stores the eight bytes around the value, so writing two neighboured values
+ *  of the same leaf concurrently is a data race.
+ * \tparam T_Value type of the leaf
+ * \tparam T_bits number of bits stored per value
+ */
+template<
+    typename T_Value,
+    std::size_t T_bits
+>
+struct BitPackedRef : ProxyRefOpMixin<
+    BitPackedRef<
+        T_Value,
+        T_bits
+    >,
+    T_Value
+>
+{
+    static_assert(
+        std::is_integral< T_Value >::value,
+        "Only integral and boolean leaves can be bit packed"
+    );
+    static_assert(
+        T_bits > 0 && T_bits <= 57,
+        "The bit width of a packed leaf needs to be between 1 and 57"
+    );
+    static_assert(
+        T_bits <= std::numeric_limits< T_Value >::digits
+            + std::size_t( std::is_signed< T_Value >::value ),
+        "The bit width of a packed leaf is bigger than its type"
+    );
+
+    /**
+     * \param bytes byte containing the first bit of the value
+     * \param shift position of the first bit of the value inside this byte
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    BitPackedRef(
+        unsigned char * const bytes,
+        unsigned const shift
+    ) :
+        bytes( bytes ),
+        shift( shift )
+    { }
+
+    BitPackedRef( BitPackedRef const & ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    operator T_Value() const
+    {
+        std::uint64_t value = ( load() >> shift ) & mask();
+        if ( std::is_signed< T_Value >::value && ( value >> ( T_bits - 1 ) ) )
+            value |= ~mask();
+        return T_Value( value );
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator=( T_Value const value )
+    -> BitPackedRef &
+    {
+        store(
+            ( load() & ~( mask() << shift ) )
+            | ( ( std::uint64_t( value ) & mask() ) << shift )
+        );
+        return *this;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator=( BitPackedRef const & other )
+    -> BitPackedRef &
+    {
+        return *this = T_Value( other );
+    }
+
+    /// byte containing the first bit of the value
+    unsigned char * const bytes;
+    /// position of the first bit of the value inside this byte
+    unsigned const shift;
+
+private:
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    mask()
+    -> std::uint64_t
+    {
+        return ( std::uint64_t( 1 ) << T_bits ) - 1;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    load() const
+    -> std::uint64_t
+    {
+        // written out, so that compilers merge it to one (unaligned) load
+        return std::uint64_t( bytes[ 0 ] )
+            | std::uint64_t( bytes[ 1 ] ) << 8
+            | std::uint64_t( bytes[ 2 ] ) << 16
+            | std::uint64_t( bytes[ 3 ] ) << 24
+            | std::uint64_t( bytes[ 4 ] ) << 32
+            | std::uint64_t( bytes[ 5 ] ) << 40
+            | std::uint64_t( bytes[ 6 ] ) << 48
+            | std::uint64_t( bytes[ 7 ] ) << 56;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    store( std::uint64_t const word ) const
+    -> void
+    {
+        bytes[ 0 ] = static_cast< unsigned char >( word );
+        bytes[ 1 ] = static_cast< unsigned char >( word >> 8 );
+        bytes[ 2 ] = static_cast< unsigned char >( word >> 16 );
+        bytes[ 3 ] = static_cast< unsigned char >( word >> 24 );
+        bytes[ 4 ] = static_cast< unsigned char >( word >> 32 );
+        bytes[ 5 ] = static_cast< unsigned char >( word >> 40 );
+        bytes[ 6 ] = static_cast< unsigned char >( word >> 48 );
+        bytes[ 7 ] = static_cast< unsigned char >( word >> 56 );
+    }
+};
+
+namespace internal
+{
+
+template< typename T_DatumCoord >
+struct IsBitFieldOf
+{
+    template< typename T_BitField >
+    using fn = IsPrefixOf<
+        typename T_BitField::DatumCoord,
+        T_DatumCoord
+    >;
+};
+
+template<
+    typename T_BitFields,
+    typename T_DatumCoord
+>
+using BitFieldIndex = boost::mp11::mp_find_if<
+    T_BitFields,
+    IsBitFieldOf< T_DatumCoord >::template fn
+>;
+
+template<
+    typename T_DatumDomain,
+    typename T_BitFields
+>
+struct IsPackedLeaf
+{
+    template< typename T_LeafIndex >
+    using fn = boost::mp11::mp_bool< BitFieldIndex<
+        T_BitFields,
+        boost::mp11::mp_at<
+            FlatDatumCoords< T_DatumDomain >,
+            T_LeafIndex
+        >
+    >::value < boost::mp11::mp_size< T_BitFields >::value >;
+};
+
+template<
+    typename T_DatumDomain,
+    typename T_BitFields
+>
+struct PackedLeafBits
+{
+    template< typename T_LeafIndex >
+    using fn = boost::mp11::mp_size_t< boost::mp11::mp_eval_if_c<
+        !IsPackedLeaf<
+            T_DatumDomain,
+            T_BitFields
+        >::template fn< T_LeafIndex >::value,
+        BitField< DatumCoord< >, 0 >,
+        boost::mp11::mp_at,
+        T_BitFields,
+        BitFieldIndex<
+            T_BitFields,
+            boost::mp11::mp_at<
+                FlatDatumCoords< T_DatumDomain >,
+                T_LeafIndex
+            >
+        >
+    >::bits >;
+};
+
+template<
+    typename T_DatumDomain,
+    typename T_BitFields,
+    std::size_t T_leafCount
+>
+using PackedBitsBefore = boost::mp11::mp_apply<
+    boost::mp11::mp_plus,
+    boost::mp11::mp_push_back<
+        boost::mp11::mp_transform<
+            PackedLeafBits<
+                T_DatumDomain,
+                T_BitFields
+            >::template fn,
+            boost::mp11::mp_iota_c< T_leafCount >
+        >,
+        boost::mp11::mp_size_t< 0 >
+    >
+>;
+
+template< bool T_packed >
+struct BitPackDispatch
+{
+    template<
+        typename T_DatumCoord,
+        typename T_BitPack
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobByte(
+        T_BitPack const & pack,
+        typename T_BitPack::UserDomain const coord
+    )
+    -> typename T_BitPack::IndexType
+    {
+        return typename T_BitPack::IndexType(
+            pack.template bitPosition< T_DatumCoord >( coord ) / 8
+        );
+    }
+
+    template<
+        typename T_DatumCoord,
+        typename T_BitPack
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobNr(
+        T_BitPack const &,
+        typename T_BitPack::UserDomain const
+    )
+    -> std::size_t
+    {
+        return 0;
+    }
+};
+
+template< >
+struct BitPackDispatch< false >
+{
+    template<
+        typename T_DatumCoord,
+        typename T_BitPack
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobByte(
+        T_BitPack const & pack,
+        typename T_BitPack::UserDomain const coord
+    )
+    -> typename T_BitPack::IndexType
+    {
+        return pack.restMapping.template getBlobByte<
+            T_BitPack::template restIndex< T_DatumCoord >()
+        >( coord );
+    }
+
+    template<
+        typename T_DatumCoord,
+        typename T_BitPack
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobNr(
+        T_BitPack const & pack,
+        typename T_BitPack::UserDomain const coord
+    )
+    -> std::size_t
+    {
+        return 1 + pack.restMapping.template getBlobNr<
+            T_BitPack::template restIndex< T_DatumCoord >()
+        >( coord );
+    }
+};
+
+} // namespace internal
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory.
+ *  For the interface details see \ref Factory. Integral and boolean leaves
+ *  with a declared bit width (e.g. a 3 bit material id or a 1 bit flag) are
+ *  bit packed into the first blob, every leaf as one bit stream over the
+ *  linearized user domain. The view returns a proxy reference
+ *  (\ref BitPackedRef) for them, which behaves mostly like a reference, but
+ *  `auto` variables initialized with it keep referring to the memory. All
+ *  other leaves are laid out by a second mapping in the blobs after the first
+ *  one.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_BitFields `boost::mp11::mp_list` of \ref BitField with the bit
+ *  widths of the packed leaves or branches. The first matching entry counts.
+ * \tparam T_RestMapping mapping template taking a user domain and a datum
+ *  domain used for all not packed leaves as flat datum domain in their
+ *  original order, e.g. \ref SoA (default) or \ref AoS
+ * \tparam T_LinearizeUserDomainAdressFunctor Defines how the user domain
+ *  should be mapped into linear numbers for the bit streams
+ * \tparam T_ExtentUserDomainAdressFunctor Defines how the total number of
+ *  \ref UserDomain indices is calculated
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_BitFields,
+    template< typename... > class T_RestMapping = SoA,
+    typename T_LinearizeUserDomainAdressFunctor =
+        LinearizeUserDomainAdress< T_UserDomain::count >,
+    typename T_ExtentUserDomainAdressFunctor =
+        ExtentUserDomainAdress< T_UserDomain::count >
+>
+struct BitPack
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    using BitFields = T_BitFields;
+    /// leaf indices not packed and given to the rest mapping
+    using LeavesRest = boost::mp11::mp_remove_if<
+        internal::LeafIndices< DatumDomain >,
+        internal::IsPackedLeaf<
+            DatumDomain,
+            BitFields
+        >::template fn
+    >;
+    using RestMapping = T_RestMapping<
+        UserDomainSize,
+        boost::mp11::mp_transform<
+            internal::PermutedDatumElement< DatumDomain >::template fn,
+            LeavesRest
+        >
+    >;
+    static constexpr std::size_t blobCount = 1 + RestMapping::blobCount;
+    /// sum of the bit widths of all packed leaves
+    static constexpr std::size_t bitsPerDatum = internal::PackedBitsBefore<
+        DatumDomain,
+        BitFields,
+        LeafCount< DatumDomain >::value
+    >::value;
+
+    /** Tells the \ref View that packed leaves are not addressable and need
+     *  to be accessed with \ref compute.
+     */
+    template< std::size_t... T_datumDomainCoord >
+    using IsComputed = typename internal::IsPackedLeaf<
+        DatumDomain,
+        BitFields
+    >::template fn< boost::mp11::mp_size_t< LinearLeafIndex<
+        DatumDomain,
+        T_datumDomainCoord...
+    >::value > >;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    BitPack( UserDomainSize const size ) :
+        userDomainSize( size ),
+        linearizeUserDomainAdress( llama::internal::makeLinearizer<
+            T_LinearizeUserDomainAdressFunctor
+        >( size ) ),
+        extentUserDomainAdress(
+            T_ExtentUserDomainAdressFunctor()( userDomainSize )
+        ),
+        restMapping( size )
+    { }
+
+    BitPack() = default;
+    BitPack( BitPack const & ) = default;
+    BitPack( BitPack && ) = default;
+    ~BitPack( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return blobNr == 0 ?
+            ( extentUserDomainAdress * bitsPerDatum + 7 ) / 8
+                + sizeof( std::uint64_t ) :
+            restMapping.getBlobSize( blobNr - 1 );
+    }
+
+    /** For packed leaves the byte containing the first bit of the value */
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return Dispatch< T_datumDomainCoord... >::template getBlobByte<
+            DatumCoord< T_datumDomainCoord... >
+        >( *this, coord );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return Dispatch< T_datumDomainCoord... >::template getBlobNr<
+            DatumCoord< T_datumDomainCoord... >
+        >( *this, coord );
+    }
+
+    /// bit width of a packed leaf
+    template< typename T_DatumCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    bitsOf()
+    -> std::size_t
+    {
+        return boost::mp11::mp_at<
+            BitFields,
+            internal::BitFieldIndex<
+                BitFields,
+                T_DatumCoord
+            >
+        >::bits;
+    }
+
+    /// position of the first bit of a packed leaf in the first blob
+    template< typename T_DatumCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    bitPosition( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return internal::PackedBitsBefore<
+                DatumDomain,
+                BitFields,
+                boost::mp11::mp_find<
+                    FlatDatumCoords< DatumDomain >,
+                    T_DatumCoord
+                >::value
+            >::value * extentUserDomainAdress
+            + std::size_t( linearizeUserDomainAdress(
+                coord,
+                userDomainSize
+            ) ) * bitsOf< T_DatumCoord >();
+    }
+
+    /// index of a not packed leaf in the rest mapping
+    template< typename T_DatumCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    restIndex()
+    -> std::size_t
+    {
+        return boost::mp11::mp_find<
+            LeavesRest,
+            boost::mp11::mp_size_t< boost::mp11::mp_find<
+                FlatDatumCoords< DatumDomain >,
+                T_DatumCoord
+            >::value >
+        >::value;
+    }
+
+    /** Gives the proxy reference to a packed leaf.
+     * \param coord coordinate in the user domain
+     * \param blobs blobs of the view
+     * \return \ref BitPackedRef to the value
+     */
+    template<
+        std::size_t... T_datumDomainCoord,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    compute(
+        UserDomain const coord,
+        T_Blobs & blobs
+    ) const
+    -> BitPackedRef<
+        GetType<
+            DatumDomain,
+            T_datumDomainCoord...
+        >,
+        bitsOf< DatumCoord< T_datumDomainCoord... > >()
+    >
+    {
+        std::size_t const bit =
+            bitPosition< DatumCoord< T_datumDomainCoord... > >( coord );
+        return BitPackedRef<
+            GetType<
+                DatumDomain,
+                T_datumDomainCoord...
+            >,
+            bitsOf< DatumCoord< T_datumDomainCoord... > >()
+        >{
+            reinterpret_cast< unsigned char * >( &blobs[ 0 ][ 0 ] ) + bit / 8,
+            unsigned( bit % 8 )
+        };
+    }
+
+    UserDomainSize const userDomainSize;
+    T_LinearizeUserDomainAdressFunctor const linearizeUserDomainAdress;
+    std::size_t const extentUserDomainAdress;
+    RestMapping const restMapping;
+
+private:
+    template< std::size_t... T_datumDomainCoord >
+    using Dispatch = internal::BitPackDispatch< IsComputed<
+        T_datumDomainCoord...
+    >::value >;
+};
+
+} // namespace mapping
+
+} // namespace llama
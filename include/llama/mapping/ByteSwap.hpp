@@ -0,0 +1,314 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+#include "../Proxy.hpp"
+#include "SoA.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+namespace internal
+{
+
+/* The swaps are written as shifts and masks, which compilers recognize as
+ * byte swap instruction and vectorize as byte shuffle in loops.
+ */
+template< std::size_t T_size >
+struct ByteSwapImpl;
+
+template< >
+struct ByteSwapImpl< 2 >
+{
+    using Word = std::uint16_t;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    apply( Word const word )
+    -> Word
+    {
+        return Word( ( word >> 8 ) | ( word << 8 ) );
+    }
+};
+
+template< >
+struct ByteSwapImpl< 4 >
+{
+    using Word = std::uint32_t;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    apply( Word const word )
+    -> Word
+    {
+        return ( word >> 24 )
+            | ( ( word >> 8 ) & 0x0000ff00u )
+            | ( ( word << 8 ) & 0x00ff0000u )
+            | ( word << 24 );
+    }
+};
+
+template< >
+struct ByteSwapImpl< 8 >
+{
+    using Word = std::uint64_t;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    apply( Word const word )
+    -> Word
+    {
+        return Word( ByteSwapImpl< 4 >::apply( std::uint32_t( word ) ) ) << 32
+            | ByteSwapImpl< 4 >::apply( std::uint32_t( word >> 32 ) );
+    }
+};
+
+} // namespace internal
+
+/** Reverses the byte order of a value, e.g. to convert between big and little
+ *  endian.
+ * \tparam T trivially copyable type with a size of 2, 4 or 8 bytes
+ * \param value value to swap
+ * \return value with reversed bytes
+ */
+template< typename T >
+LLAMA_FN_HOST_ACC_INLINE
+auto
+byteSwap( T const value )
+-> T
+{
+    using Impl = internal::ByteSwapImpl< sizeof( T ) >;
+    typename Impl::Word word;
+    std::memcpy( &word, &value, sizeof( T ) );
+    word = Impl::apply( word );
+    T result;
+    std::memcpy( &result, &word, sizeof( T ) );
+    return result;
+}
+
+/** Reverses the byte order of an array of values element wise, e.g. of a
+ *  contiguous leaf of a \ref ByteSwap mapping with a \ref SoA inner mapping
+ *  when copying it to or from a native view. The loop has no dependencies
+ *  between elements, so it can be vectorized. Source and destination may be
+ *  the same array.
+ * \param source first of `count` values to swap
+ * \param destination first of `count` swapped values
+ * \param count number of values
+ */
+template< typename T >
+LLAMA_FN_HOST_ACC_INLINE
+auto
+byteSwapArray(
+    T const * const source,
+    T * const destination,
+    std::size_t const count
+)
+-> void
+{
+    LLAMA_INDEPENDENT_DATA
+    for ( std::size_t i = 0; i < count; ++i )
+        destination[ i ] = byteSwap( source[ i ] );
+}
+
+/** Proxy reference to a value of \ref ByteSwap, which reverses the byte order
+ *  on reading and writing.
+ * \tparam T_Value type of the leaf
+ */
+template< typename T_Value >
+struct ByteSwappedRef : ProxyRefOpMixin<
+    ByteSwappedRef< T_Value >,
+    T_Value
+>
+{
+    /// \param bytes first byte of the stored value
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit ByteSwappedRef( unsigned char * const bytes ) :
+        bytes( bytes )
+    { }
+
+    ByteSwappedRef( ByteSwappedRef const & ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    operator T_Value() const
+    {
+        T_Value stored;
+        std::memcpy( &stored, bytes, sizeof( T_Value ) );
+        return byteSwap( stored );
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator=( T_Value const value )
+    -> ByteSwappedRef &
+    {
+        T_Value const stored = byteSwap( value );
+        std::memcpy( bytes, &stored, sizeof( T_Value ) );
+        return *this;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator=( ByteSwappedRef const & other )
+    -> ByteSwappedRef &
+    {
+        return *this = T_Value( other );
+    }
+
+    /// first byte of the stored value
+    unsigned char * const bytes;
+};
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory.
+ *  For the interface details see \ref Factory. All leaves are laid out by an
+ *  inner mapping, but stored in the opposite byte order, e.g. big endian on a
+ *  little endian machine. So foreign data like big endian files can be used
+ *  in place by creating a \ref View with this mapping directly on the raw
+ *  buffer. The view returns a proxy reference (\ref ByteSwappedRef) for all
+ *  leaves bigger than one byte, which swaps the bytes on every access, but
+ *  `auto` variables initialized with it keep referring to the memory. With
+ *  e.g. \ref SoA as inner mapping whole leaves can be converted at once with
+ *  \ref byteSwapArray.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain, which may only contain
+ *  leaves with 1, 2, 4 or 8 bytes
+ * \tparam T_InnerMapping mapping template taking a user domain and a datum
+ *  domain giving the layout of the swapped data, e.g. \ref SoA (default) or
+ *  \ref AoS
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    template< typename... > class T_InnerMapping = SoA
+>
+struct ByteSwap
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    using InnerMapping = T_InnerMapping<
+        UserDomainSize,
+        DatumDomain
+    >;
+    static constexpr std::size_t blobCount = InnerMapping::blobCount;
+
+    /** Tells the \ref View that leaves bigger than one byte need to be
+     *  accessed with \ref compute.
+     */
+    template< std::size_t... T_datumDomainCoord >
+    using IsComputed = boost::mp11::mp_bool< ( sizeof( GetType<
+        DatumDomain,
+        T_datumDomainCoord...
+    > ) > 1 ) >;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    ByteSwap( UserDomainSize const size ) :
+        userDomainSize( size ),
+        innerMapping( size )
+    { }
+
+    ByteSwap() = default;
+    ByteSwap( ByteSwap const & ) = default;
+    ByteSwap( ByteSwap && ) = default;
+    ~ByteSwap( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return innerMapping.getBlobSize( blobNr );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return innerMapping.template getBlobByte< T_datumDomainCoord... >(
+            coord
+        );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return innerMapping.template getBlobNr< T_datumDomainCoord... >(
+            coord
+        );
+    }
+
+    /** Gives the byte swapping proxy reference to a leaf.
+     * \param coord coordinate in the user domain
+     * \param blobs blobs of the view
+     * \return \ref ByteSwappedRef to the value
+     */
+    template<
+        std::size_t... T_datumDomainCoord,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    compute(
+        UserDomain const coord,
+        T_Blobs & blobs
+    ) const
+    -> ByteSwappedRef< GetType<
+        DatumDomain,
+        T_datumDomainCoord...
+    > >
+    {
+        return ByteSwappedRef< GetType<
+            DatumDomain,
+            T_datumDomainCoord...
+        > >(
+            reinterpret_cast< unsigned char * >( &blobs[
+                getBlobNr< T_datumDomainCoord... >( coord )
+            ][
+                getBlobByte< T_datumDomainCoord... >( coord )
+            ] )
+        );
+    }
+
+    UserDomainSize const userDomainSize;
+    InnerMapping const innerMapping;
+};
+
+} // namespace mapping
+
+} // namespace llama
@@ -0,0 +1,508 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../GetCoordFromUID.hpp"
+#include "../UserDomain.hpp"
+#include "../Proxy.hpp"
+#include "Reorder.hpp"
+#include "SoA.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Declares a leaf of the datum domain for \ref Computed, which has no
+ *  storage but is computed from other leaves of the same datum on reading.
+ * \tparam T_DatumCoord \ref DatumCoord of the leaf, e.g. gotten with
+ *  \ref GetCoordFromUID
+ * \tparam T_Functor default constructible functor with a
+ *  `template< typename Datum > operator()( Datum const & ) const` returning
+ *  the value of the leaf. The datum can be read like a \ref VirtualDatum with
+ *  unique identifiers or a \ref DatumCoord, e.g. `datum( Vel(), X() )`.
+ */
+template<
+    typename T_DatumCoord,
+    typename T_Functor
+>
+struct ComputedField
+{
+    using DatumCoord = T_DatumCoord;
+    using Functor = T_Functor;
+};
+
+/** Proxy reference to a leaf of \ref Computed. It holds the computed value
+ *  and can't be written, so assigning a value to it is a compile error.
+ *  Operations on whole datums skip it, so whole datums can still be assigned
+ *  and the computed leaf follows the leaves it is computed from.
+ * \tparam T_Value type of the leaf
+ */
+template< typename T_Value >
+struct ComputedRef : ProxyRefOpMixin<
+    ComputedRef< T_Value >,
+    T_Value
+>
+{
+    /// \param value computed value of the leaf
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit ComputedRef( T_Value const value ) :
+        value( value )
+    { }
+
+    ComputedRef( ComputedRef const & ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    operator T_Value() const
+    {
+        return value;
+    }
+
+    auto
+    operator=( T_Value const )
+    -> ComputedRef & = delete;
+
+    auto
+    operator=( ComputedRef const & )
+    -> ComputedRef & = delete;
+
+    /// computed value of the leaf
+    T_Value const value;
+};
+
+template<
+    typename T_Mapping,
+    typename T_Blobs
+>
+struct ComputedFieldDatum;
+
+namespace internal
+{
+
+template< typename T_DatumCoord >
+struct IsComputedFieldOf
+{
+    template< typename T_ComputedField >
+    using fn = std::is_same<
+        typename T_ComputedField::DatumCoord,
+        T_DatumCoord
+    >;
+};
+
+template<
+    typename T_DatumDomain,
+    typename T_ComputedFields
+>
+struct IsComputedFieldLeaf
+{
+    template< typename T_LeafIndex >
+    using fn = boost::mp11::mp_bool< boost::mp11::mp_find_if<
+        T_ComputedFields,
+        IsComputedFieldOf< boost::mp11::mp_at<
+            FlatDatumCoords< T_DatumDomain >,
+            T_LeafIndex
+        > >::template fn
+    >::value < boost::mp11::mp_size< T_ComputedFields >::value >;
+};
+
+template< typename T_StoredMapping >
+struct IsComputedStoredLeaf
+{
+    template< typename T_LeafIndex >
+    using fn = llama::internal::IsComputedLeaf<
+        T_StoredMapping,
+        DatumCoord< T_LeafIndex::value >
+    >;
+};
+
+template< typename T_DatumCoord >
+struct ComputedReadCaller;
+
+template< std::size_t... T_coords >
+struct ComputedReadCaller< DatumCoord< T_coords... > >
+{
+    template<
+        typename T_Mapping,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    apply(
+        T_Mapping const & mapping,
+        typename T_Mapping::UserDomain const coord,
+        T_Blobs & blobs
+    )
+    -> GetType<
+        typename T_Mapping::DatumDomain,
+        T_coords...
+    >
+    {
+        return mapping.template read< T_coords... >( coord, blobs );
+    }
+};
+
+template< bool T_computed >
+struct ComputedDispatch
+{
+    template<
+        typename T_DatumCoord,
+        typename T_Mapping,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    read(
+        T_Mapping const & mapping,
+        typename T_Mapping::UserDomain const coord,
+        T_Blobs & blobs
+    )
+    -> GetTypeFromDatumCoord<
+        typename T_Mapping::DatumDomain,
+        T_DatumCoord
+    >
+    {
+        return GetTypeFromDatumCoord<
+            typename T_Mapping::DatumDomain,
+            T_DatumCoord
+        >( typename T_Mapping::template FunctorOf< T_DatumCoord >()(
+            ComputedFieldDatum<
+                T_Mapping,
+                T_Blobs
+            >{
+                mapping,
+                blobs,
+                coord
+            }
+        ) );
+    }
+};
+
+template< >
+struct ComputedDispatch< false >
+{
+    template<
+        typename T_DatumCoord,
+        typename T_Mapping,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    read(
+        T_Mapping const & mapping,
+        typename T_Mapping::UserDomain const coord,
+        T_Blobs & blobs
+    )
+    -> GetTypeFromDatumCoord<
+        typename T_Mapping::DatumDomain,
+        T_DatumCoord
+    >
+    {
+        constexpr std::size_t index =
+            T_Mapping::template storedIndex< T_DatumCoord >();
+        return reinterpret_cast< GetTypeFromDatumCoord<
+            typename T_Mapping::DatumDomain,
+            T_DatumCoord
+        > const & >( blobs[
+            mapping.storedMapping.template getBlobNr< index >( coord )
+        ][
+            mapping.storedMapping.template getBlobByte< index >( coord )
+        ] );
+    }
+};
+
+} // namespace internal
+
+/** Datum given to the functor of a \ref ComputedField, which reads the other
+ *  leaves of the same datum like a \ref VirtualDatum.
+ * \tparam T_Mapping the \ref Computed mapping
+ * \tparam T_Blobs type of the blobs of the view
+ */
+template<
+    typename T_Mapping,
+    typename T_Blobs
+>
+struct ComputedFieldDatum
+{
+    /** Reads a leaf given as tree coordinates.
+     * \tparam T_coord... variadic number std::size_t numbers as tree
+     *  coordinates
+     * \return value of the leaf
+     */
+    template< std::size_t... T_coord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    access() const
+    -> GetType<
+        typename T_Mapping::DatumDomain,
+        T_coord...
+    >
+    {
+        return mapping.template read< T_coord... >( userDomainPos, blobs );
+    }
+
+    /** Reads a leaf given as unique identifiers or \ref DatumCoord.
+     * \return value of the leaf
+     */
+    template< typename... T_DatumCoordOrUIDs >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator()( T_DatumCoordOrUIDs... ) const
+    -> GetTypeFromDatumCoord<
+        typename T_Mapping::DatumDomain,
+        llama::internal::ResolveDatumCoord<
+            typename T_Mapping::DatumDomain,
+            T_DatumCoordOrUIDs...
+        >
+    >
+    {
+        return internal::ComputedReadCaller< llama::internal::ResolveDatumCoord<
+            typename T_Mapping::DatumDomain,
+            T_DatumCoordOrUIDs...
+        > >::apply(
+            mapping,
+            userDomainPos,
+            blobs
+        );
+    }
+
+    T_Mapping const & mapping;
+    T_Blobs & blobs;
+    /// position of the datum in the user domain
+    typename T_Mapping::UserDomain const userDomainPos;
+};
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory.
+ *  For the interface details see \ref Factory. Selected leaves have no
+ *  storage, but are computed on every read from other leaves of the same
+ *  datum by a functor, e.g. the kinetic energy from velocity and mass. So
+ *  derived quantities neither need memory nor need to be kept in sync, while
+ *  kernels still read them like every other leaf. The view returns a
+ *  \ref ComputedRef for them, which can't be written. All other leaves
+ *  are laid out by an inner mapping as flat datum domain in their original
+ *  order.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain including the computed
+ *  leaves with the type they are read as
+ * \tparam T_ComputedFields `boost::mp11::mp_list` of \ref ComputedField with
+ *  the computed leaves and their functors
+ * \tparam T_StoredMapping mapping template taking a user domain and a datum
+ *  domain used for all stored leaves, e.g. \ref SoA (default) or \ref AoS.
+ *  The leaves are read directly from its blobs, so it may not compute leaves
+ *  on access itself like e.g. \ref BitPack.
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_ComputedFields,
+    template< typename... > class T_StoredMapping = SoA
+>
+struct Computed
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    using ComputedFields = T_ComputedFields;
+    /// leaf indices with storage given to the stored mapping
+    using LeavesStored = boost::mp11::mp_remove_if<
+        internal::LeafIndices< DatumDomain >,
+        internal::IsComputedFieldLeaf<
+            DatumDomain,
+            ComputedFields
+        >::template fn
+    >;
+    using StoredMapping = T_StoredMapping<
+        UserDomainSize,
+        boost::mp11::mp_transform<
+            internal::PermutedDatumElement< DatumDomain >::template fn,
+            LeavesStored
+        >
+    >;
+    static constexpr std::size_t blobCount = StoredMapping::blobCount;
+
+    static_assert(
+        !boost::mp11::mp_any_of<
+            boost::mp11::mp_iota< boost::mp11::mp_size< LeavesStored > >,
+            internal::IsComputedStoredLeaf< StoredMapping >::template fn
+        >::value,
+        "The stored mapping may not compute leaves on access"
+    );
+
+    /// functor of a computed leaf
+    template< typename T_DatumCoord >
+    using FunctorOf = typename boost::mp11::mp_at<
+        ComputedFields,
+        boost::mp11::mp_find_if<
+            ComputedFields,
+            internal::IsComputedFieldOf< T_DatumCoord >::template fn
+        >
+    >::Functor;
+
+    /** Tells the \ref View that computed leaves have no storage and need to
+     *  be accessed with \ref compute.
+     */
+    template< std::size_t... T_datumDomainCoord >
+    using IsComputed = typename internal::IsComputedFieldLeaf<
+        DatumDomain,
+        ComputedFields
+    >::template fn< boost::mp11::mp_size_t< LinearLeafIndex<
+        DatumDomain,
+        T_datumDomainCoord...
+    >::value > >;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    Computed( UserDomainSize const size ) :
+        userDomainSize( size ),
+        storedMapping( size )
+    { }
+
+    Computed() = default;
+    Computed( Computed const & ) = default;
+    Computed( Computed && ) = default;
+    ~Computed( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return storedMapping.getBlobSize( blobNr );
+    }
+
+    /** Only defined for stored leaves */
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        static_assert(
+            !IsComputed< T_datumDomainCoord... >::value,
+            "Computed leaves have no storage"
+        );
+        return storedMapping.template getBlobByte< storedIndex<
+            DatumCoord< T_datumDomainCoord... >
+        >() >( coord );
+    }
+
+    /** Only defined for stored leaves */
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        static_assert(
+            !IsComputed< T_datumDomainCoord... >::value,
+            "Computed leaves have no storage"
+        );
+        return storedMapping.template getBlobNr< storedIndex<
+            DatumCoord< T_datumDomainCoord... >
+        >() >( coord );
+    }
+
+    /// index of a stored leaf in the stored mapping
+    template< typename T_DatumCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    storedIndex()
+    -> std::size_t
+    {
+        return boost::mp11::mp_find<
+            LeavesStored,
+            boost::mp11::mp_size_t< boost::mp11::mp_find<
+                FlatDatumCoords< DatumDomain >,
+                T_DatumCoord
+            >::value >
+        >::value;
+    }
+
+    /** Reads the value of a stored or computed leaf.
+     * \param coord coordinate in the user domain
+     * \param blobs blobs of the view
+     * \return value of the leaf
+     */
+    template<
+        std::size_t... T_datumDomainCoord,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    read(
+        UserDomain const coord,
+        T_Blobs & blobs
+    ) const
+    -> GetType<
+        DatumDomain,
+        T_datumDomainCoord...
+    >
+    {
+        return internal::ComputedDispatch< IsComputed<
+            T_datumDomainCoord...
+        >::value >::template read< DatumCoord< T_datumDomainCoord... > >(
+            *this,
+            coord,
+            blobs
+        );
+    }
+
+    /** Gives the proxy reference with the value of a computed leaf.
+     * \param coord coordinate in the user domain
+     * \param blobs blobs of the view
+     * \return \ref ComputedRef with the value
+     */
+    template<
+        std::size_t... T_datumDomainCoord,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    compute(
+        UserDomain const coord,
+        T_Blobs & blobs
+    ) const
+    -> ComputedRef< GetType<
+        DatumDomain,
+        T_datumDomainCoord...
+    > >
+    {
+        return ComputedRef< GetType<
+            DatumDomain,
+            T_datumDomainCoord...
+        > >( read< T_datumDomainCoord... >( coord, blobs ) );
+    }
+
+    UserDomainSize const userDomainSize;
+    StoredMapping const storedMapping;
+};
+
+} // namespace mapping
+
+} // namespace llama
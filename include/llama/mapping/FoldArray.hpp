@@ -0,0 +1,502 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+#include "Split.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+namespace internal
+{
+
+template< typename T_Element >
+struct FoldedDatumDomainImpl
+{
+    using type = DatumStruct< DatumElement< NoName, T_Element > >;
+};
+
+template< typename... T_DatumElements >
+struct FoldedDatumDomainImpl< DatumStruct< T_DatumElements... > >
+{
+    using type = DatumStruct< T_DatumElements... >;
+};
+
+template<
+    typename T_Element,
+    typename T_ElementCoord
+>
+struct FoldedDatumCoordImpl
+{
+    using type = DatumCoord< 0 >;
+};
+
+template<
+    typename T_ElementCoord,
+    typename... T_DatumElements
+>
+struct FoldedDatumCoordImpl<
+    DatumStruct< T_DatumElements... >,
+    T_ElementCoord
+>
+{
+    using type = T_ElementCoord;
+};
+
+template< typename T_DatumCoord >
+struct FoldedMappingCaller;
+
+template< std::size_t... T_coords >
+struct FoldedMappingCaller< DatumCoord< T_coords... > >
+{
+    template<
+        typename T_Mapping,
+        typename T_UserDomain
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobByte(
+        T_Mapping const & mapping,
+        T_UserDomain const & coord
+    )
+    -> decltype( mapping.template getBlobByte< T_coords... >( coord ) )
+    {
+        return mapping.template getBlobByte< T_coords... >( coord );
+    }
+
+    template<
+        typename T_Mapping,
+        typename T_UserDomain
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobNr(
+        T_Mapping const & mapping,
+        T_UserDomain const & coord
+    )
+    -> std::size_t
+    {
+        return mapping.template getBlobNr< T_coords... >( coord );
+    }
+};
+
+template< bool T_folded >
+struct FoldArrayDispatch
+{
+    template<
+        typename T_DatumCoord,
+        typename T_FoldArray
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobByte(
+        T_FoldArray const & fold,
+        typename T_FoldArray::UserDomain const coord
+    )
+    -> typename T_FoldArray::IndexType
+    {
+        return FoldedMappingCaller<
+            typename T_FoldArray::template FoldedDatumCoord< T_DatumCoord >
+        >::getBlobByte(
+            fold.arrayMapping,
+            fold.unfold(
+                coord,
+                T_FoldArray::template ElementCoord< T_DatumCoord >::front
+            )
+        );
+    }
+
+    template<
+        typename T_DatumCoord,
+        typename T_FoldArray
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobNr(
+        T_FoldArray const & fold,
+        typename T_FoldArray::UserDomain const coord
+    )
+    -> std::size_t
+    {
+        return FoldedMappingCaller<
+            typename T_FoldArray::template FoldedDatumCoord< T_DatumCoord >
+        >::getBlobNr(
+            fold.arrayMapping,
+            fold.unfold(
+                coord,
+                T_FoldArray::template ElementCoord< T_DatumCoord >::front
+            )
+        );
+    }
+};
+
+template< >
+struct FoldArrayDispatch< false >
+{
+    template<
+        typename T_DatumCoord,
+        typename T_FoldArray
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobByte(
+        T_FoldArray const & fold,
+        typename T_FoldArray::UserDomain const coord
+    )
+    -> typename T_FoldArray::IndexType
+    {
+        return fold.restMapping.template getBlobByte<
+            T_FoldArray::template restIndex< T_DatumCoord >()
+        >( coord );
+    }
+
+    template<
+        typename T_DatumCoord,
+        typename T_FoldArray
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobNr(
+        T_FoldArray const & fold,
+        typename T_FoldArray::UserDomain const coord
+    )
+    -> std::size_t
+    {
+        return T_FoldArray::ArrayMapping::blobCount
+            + fold.restMapping.template getBlobNr<
+                T_FoldArray::template restIndex< T_DatumCoord >()
+            >( coord );
+    }
+};
+
+} // namespace internal
+
+/** Mapping adaptor which can be used for creating a \ref View with a
+ *  \ref Factory. For the interface details see \ref Factory. The index of one
+ *  \ref DatumArray of the datum domain is folded into an extra, innermost run
+ *  time dimension of the user domain, e.g. the 19 distribution values of a
+ *  lattice Boltzmann cell. The array is laid out by its own mapping with this
+ *  extended user domain and the array element as datum domain, so its
+ *  elements are a strided run time array instead of many compile time leaves
+ *  and every element uses the same code path. All other leaves are laid out
+ *  by a second mapping with the original user domain in their own blobs
+ *  after the blobs of the array. The datum domain of the view stays the
+ *  original one, so the elements can still be addressed with their
+ *  \ref DatumCoord and \ref unfold gives the coordinate for the array mapping
+ *  directly.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_ArrayCoord \ref DatumCoord of the \ref DatumArray to fold, e.g.
+ *  gotten with \ref GetCoordFromUID
+ * \tparam T_ArrayMapping mapping template taking a user domain and a datum
+ *  domain used for the folded array, e.g. \ref SoA to store the elements of
+ *  one datum next to each other or \ref SoA with
+ *  \ref LinearizeUserDomainAdressLikeFortran to store every element index in
+ *  its own plane. Mappings with further template parameters can be given with
+ *  an alias template.
+ * \tparam T_RestMapping mapping template like `T_ArrayMapping` used for all
+ *  other leaves as flat datum domain in their original order
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_ArrayCoord,
+    template< typename... > class T_ArrayMapping,
+    template< typename... > class T_RestMapping = T_ArrayMapping
+>
+struct FoldArray
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    /// \ref DatumCoord of the folded array
+    using ArrayCoord = T_ArrayCoord;
+    using ArrayType = GetTypeFromDatumCoord<
+        DatumDomain,
+        ArrayCoord
+    >;
+    static_assert(
+        boost::mp11::mp_apply<
+            boost::mp11::mp_same,
+            boost::mp11::mp_push_front<
+                ArrayType,
+                boost::mp11::mp_first< ArrayType >
+            >
+        >::value,
+        "Only a DatumArray with identical elements can be folded"
+    );
+    /// type of every array element, a leaf type or a \ref DatumStruct
+    using ElementType = GetDatumElementType< boost::mp11::mp_first<
+        ArrayType
+    > >;
+    /// number of elements of the folded array
+    static constexpr std::size_t arraySize =
+        boost::mp11::mp_size< ArrayType >::value;
+    /// user domain of the array mapping with the element index as last entry
+    using ArrayUserDomain = llama::UserDomain<
+        UserDomain::count + 1,
+        IndexType
+    >;
+    /// datum domain of one element given to the array mapping
+    using ArrayDatumDomain =
+        typename internal::FoldedDatumDomainImpl< ElementType >::type;
+    /// leaf indices not part of the array given to the rest mapping
+    using LeavesRest = boost::mp11::mp_remove_if<
+        internal::LeafIndices< DatumDomain >,
+        internal::IsSelectedLeaf<
+            DatumDomain,
+            boost::mp11::mp_list< ArrayCoord >
+        >::template fn
+    >;
+    using ArrayMapping = T_ArrayMapping<
+        ArrayUserDomain,
+        ArrayDatumDomain
+    >;
+    using RestMapping = T_RestMapping<
+        UserDomainSize,
+        boost::mp11::mp_transform<
+            internal::PermutedDatumElement< DatumDomain >::template fn,
+            LeavesRest
+        >
+    >;
+    static constexpr std::size_t blobCount =
+        ArrayMapping::blobCount + RestMapping::blobCount;
+
+    /** \ref DatumCoord starting with the element index of a coordinate inside
+     *  the array, followed by the coordinate inside the element
+     */
+    template< typename T_DatumCoord >
+    using ElementCoord = typename T_DatumCoord::template Back<
+        T_DatumCoord::size - ArrayCoord::size
+    >;
+
+    /// \ref DatumCoord in the array mapping of a coordinate inside the array
+    template< typename T_DatumCoord >
+    using FoldedDatumCoord = typename internal::FoldedDatumCoordImpl<
+        ElementType,
+        typename ElementCoord< T_DatumCoord >::PopFront
+    >::type;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    FoldArray( UserDomainSize const size ) :
+        userDomainSize( size ),
+        arrayMapping( unfold(
+            size,
+            arraySize
+        ) ),
+        restMapping( size )
+    { }
+
+    FoldArray() = default;
+    FoldArray( FoldArray const & ) = default;
+    FoldArray( FoldArray && ) = default;
+    ~FoldArray( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return blobNr < ArrayMapping::blobCount ?
+            arrayMapping.getBlobSize( blobNr ) :
+            restMapping.getBlobSize( blobNr - ArrayMapping::blobCount );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return Dispatch< T_datumDomainCoord... >::template getBlobByte<
+            DatumCoord< T_datumDomainCoord... >
+        >( *this, coord );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return Dispatch< T_datumDomainCoord... >::template getBlobNr<
+            DatumCoord< T_datumDomainCoord... >
+        >( *this, coord );
+    }
+
+    /** Gives the byte position of a leaf in an element of the folded array
+     *  with the element index given at run time, see
+     *  \ref View::arrayAccessor. Only the folded array itself can be indexed
+     *  at run time. The element is addressed exactly with its \ref unfold
+     *  coordinate in the array mapping, so this works for every array
+     *  mapping.
+     * \param coord coordinate in the user domain
+     * \param index index of the element in the array
+     * \return byte position of the leaf
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getArrayBlobByte(
+        UserDomain const coord,
+        std::size_t const index,
+        DatumCoord< T_arrayCoord... >,
+        DatumCoord< T_elementCoord... >
+    ) const
+    -> IndexType
+    {
+        static_assert(
+            std::is_same<
+                DatumCoord< T_arrayCoord... >,
+                ArrayCoord
+            >::value,
+            "Only the folded array can be indexed at run time"
+        );
+        return internal::FoldedMappingCaller< FoldedDatumCoord< DatumCoord<
+            T_arrayCoord...,
+            0,
+            T_elementCoord...
+        > > >::getBlobByte(
+            arrayMapping,
+            unfold(
+                coord,
+                index
+            )
+        );
+    }
+
+    /** Gives the blob of a leaf in an element of the folded array with the
+     *  element index given at run time, see \ref View::arrayAccessor.
+     * \param coord coordinate in the user domain
+     * \param index index of the element in the array
+     * \return blob of the leaf
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getArrayBlobNr(
+        UserDomain const coord,
+        std::size_t const index,
+        DatumCoord< T_arrayCoord... >,
+        DatumCoord< T_elementCoord... >
+    ) const
+    -> std::size_t
+    {
+        static_assert(
+            std::is_same<
+                DatumCoord< T_arrayCoord... >,
+                ArrayCoord
+            >::value,
+            "Only the folded array can be indexed at run time"
+        );
+        return internal::FoldedMappingCaller< FoldedDatumCoord< DatumCoord<
+            T_arrayCoord...,
+            0,
+            T_elementCoord...
+        > > >::getBlobNr(
+            arrayMapping,
+            unfold(
+                coord,
+                index
+            )
+        );
+    }
+
+    /** Gives the coordinate of an array element in the user domain of the
+     *  array mapping. The blobs of the array mapping are the first blobs of
+     *  the view, so together with \ref arrayMapping the element can be
+     *  reached with a run time index.
+     * \param coord coordinate in the user domain
+     * \param index index of the element in the array
+     * \return coordinate in \ref ArrayUserDomain
+     */
+    template< typename T_UserDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    unfold(
+        T_UserDomainCoord const & coord,
+        std::size_t const index
+    )
+    -> ArrayUserDomain
+    {
+        ArrayUserDomain result;
+        for ( std::size_t i = 0; i < ArrayUserDomain::count; ++i )
+            result[ i ] = i < UserDomain::count ?
+                IndexType( coord[ i ] ) :
+                IndexType( index );
+        return result;
+    }
+
+    /// index of a leaf outside of the array in the rest mapping
+    template< typename T_DatumCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    restIndex()
+    -> std::size_t
+    {
+        return boost::mp11::mp_find<
+            LeavesRest,
+            boost::mp11::mp_size_t< boost::mp11::mp_find<
+                FlatDatumCoords< DatumDomain >,
+                T_DatumCoord
+            >::value >
+        >::value;
+    }
+
+    UserDomainSize const userDomainSize;
+    ArrayMapping const arrayMapping;
+    RestMapping const restMapping;
+
+private:
+    template< std::size_t... T_datumDomainCoord >
+    using Dispatch = internal::FoldArrayDispatch< internal::IsPrefixOf<
+        ArrayCoord,
+        DatumCoord< T_datumDomainCoord... >
+    >::value >;
+};
+
+} // namespace mapping
+
+} // namespace llama
@@ -0,0 +1,248 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../Types.hpp"
+#include "../UserDomain.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Box of coordinates `[begin, end)` in a user domain, e.g. the interior or a
+ *  part of the halo of a \ref Halo mapping. For unsigned index types the
+ *  coordinates of the halo in front of the interior wrap around, so loops over
+ *  the box should compare with `!=` (or use `forEachCoord`).
+ * \tparam T_UserDomain type of the user domain coordinates
+ */
+template< typename T_UserDomain >
+struct UserDomainRange
+{
+    /// first coordinate inside the box
+    T_UserDomain begin;
+    /// coordinate after the last one inside the box in every dimension
+    T_UserDomain end;
+
+    /** Calls a functor for every coordinate in the box in C like order.
+     * \tparam T_Functor type of the functor
+     * \param functor functor called with the coordinate as \ref UserDomain
+     */
+    template< typename T_Functor >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    forEachCoord( T_Functor && functor ) const
+    -> void
+    {
+        for ( std::size_t i = 0; i < T_UserDomain::count; ++i )
+            if ( begin[ i ] == end[ i ] )
+                return;
+        T_UserDomain coord( begin );
+        while ( true )
+        {
+            functor( coord );
+            std::size_t i = T_UserDomain::count;
+            while ( true )
+            {
+                --i;
+                if ( ++coord[ i ] != end[ i ] )
+                    break;
+                if ( i == 0 )
+                    return;
+                coord[ i ] = begin[ i ];
+            }
+        }
+    }
+};
+
+/** Mapping adaptor which can be used for creating a \ref View with a
+ *  \ref Factory. For the interface details see \ref Factory. Around the user
+ *  domain (the interior) a halo of ghost cells is reserved in every dimension,
+ *  so the view accepts coordinates in `[-haloWidth, size + haloWidth)`. The
+ *  interior and the halo are laid out together by an inner mapping, so halo
+ *  exchange and stencils work on one allocation without shifting indices by
+ *  hand. Negative coordinates can be given as signed values like
+ *  `view( -1, y )`, also for unsigned index types.
+ * \tparam T_UserDomain type of the user domain of the interior
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_InnerMapping mapping template taking a user domain and a datum
+ *  domain used to lay out the interior together with the halo, e.g. \ref SoA.
+ *  Mappings with further non-type template parameters can be given with an
+ *  alias template.
+ * \tparam T_haloWidth number of ghost cells on every side in every dimension
+ * \see UserDomainRange
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    template< typename... > class T_InnerMapping,
+    std::size_t T_haloWidth = 1u
+>
+struct Halo
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    using InnerMapping = T_InnerMapping<
+        UserDomain,
+        DatumDomain
+    >;
+    using Range = UserDomainRange< UserDomain >;
+    static constexpr std::size_t blobCount = InnerMapping::blobCount;
+    /// number of ghost cells on every side in every dimension
+    static constexpr std::size_t haloWidth = T_haloWidth;
+    /// number of disjoint boxes the halo is split into by \ref halo
+    static constexpr std::size_t haloRangeCount = 2 * UserDomain::count;
+
+    /// \param size size of the interior of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    Halo( UserDomainSize const size ) :
+        userDomainSize( size ),
+        innerMapping( paddedSize( size ) )
+    { }
+
+    Halo() = default;
+    Halo( Halo const & ) = default;
+    Halo( Halo && ) = default;
+    ~Halo( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return innerMapping.getBlobSize( blobNr );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return innerMapping.template getBlobByte< T_datumDomainCoord... >(
+            shifted( coord )
+        );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return innerMapping.template getBlobNr< T_datumDomainCoord... >(
+            shifted( coord )
+        );
+    }
+
+    /** Gives the interior of the user domain without the halo.
+     * \return box `[0, size)`
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    interior() const
+    -> Range
+    {
+        Range range;
+        for ( std::size_t i = 0; i < UserDomain::count; ++i )
+        {
+            range.begin[ i ] = 0;
+            range.end[ i ] = IndexType( userDomainSize[ i ] );
+        }
+        return range;
+    }
+
+    /** Gives one part of the halo. All \ref haloRangeCount parts together
+     *  cover the halo exactly once. Part `2 * d` is the halo in front of and
+     *  part `2 * d + 1` the halo behind the interior in dimension `d`. It
+     *  spans the interior in all dimensions before `d` and the interior
+     *  together with the halo in all dimensions after `d`.
+     * \param nr number of the part, smaller than \ref haloRangeCount
+     * \return box of the part
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    halo( std::size_t const nr ) const
+    -> Range
+    {
+        std::size_t const dim = nr / 2;
+        IndexType const width = IndexType( haloWidth );
+        Range range;
+        for ( std::size_t i = 0; i < UserDomain::count; ++i )
+        {
+            IndexType const size = IndexType( userDomainSize[ i ] );
+            if ( i < dim )
+            {
+                range.begin[ i ] = 0;
+                range.end[ i ] = size;
+            }
+            else if ( i > dim )
+            {
+                range.begin[ i ] = IndexType( 0 ) - width;
+                range.end[ i ] = size + width;
+            }
+            else if ( nr % 2 == 0 )
+            {
+                range.begin[ i ] = IndexType( 0 ) - width;
+                range.end[ i ] = 0;
+            }
+            else
+            {
+                range.begin[ i ] = size;
+                range.end[ i ] = size + width;
+            }
+        }
+        return range;
+    }
+
+    UserDomainSize const userDomainSize;
+    InnerMapping const innerMapping;
+
+private:
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    paddedSize( UserDomainSize const & size )
+    -> UserDomain
+    {
+        UserDomain result;
+        for ( std::size_t i = 0; i < UserDomain::count; ++i )
+            result[ i ] = IndexType( size[ i ] + 2 * haloWidth );
+        return result;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    shifted( UserDomain const & coord )
+    -> UserDomain
+    {
+        UserDomain result( coord );
+        for ( std::size_t i = 0; i < UserDomain::count; ++i )
+            result[ i ] += IndexType( haloWidth );
+        return result;
+    }
+};
+
+} // namespace mapping
+
+} // namespace llama
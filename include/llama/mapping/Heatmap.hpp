@@ -0,0 +1,467 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+#include "../Proxy.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+namespace internal
+{
+
+template< typename T_DatumCoord >
+struct DatumCoordWriter;
+
+template< std::size_t... T_coords >
+struct DatumCoordWriter< DatumCoord< T_coords... > >
+{
+    /// writes the coordinates separated by `separator`
+    static
+    auto
+    write(
+        std::ostream & stream,
+        char const * const separator
+    )
+    -> void
+    {
+        std::size_t const coords[] = { T_coords..., 0 };
+        for ( std::size_t i = 0; i < sizeof...( T_coords ); ++i )
+            stream << ( i == 0 ? "" : separator ) << coords[ i ];
+    }
+};
+
+template< typename T_Heatmap >
+struct HeatmapLeafWriter
+{
+    template< typename T_LeafIndex >
+    auto
+    operator()( T_LeafIndex const )
+    -> void
+    {
+        using Coord = boost::mp11::mp_at<
+            FlatDatumCoords< typename T_Heatmap::DatumDomain >,
+            T_LeafIndex
+        >;
+        std::size_t const count = heatmap.leafAccesses( T_LeafIndex::value );
+        if ( json )
+        {
+            stream << ( T_LeafIndex::value == 0 ? "" : "," )
+                << "\n    { \"coord\": [";
+            DatumCoordWriter< Coord >::write( stream, ", " );
+            stream << "], \"accesses\": " << count << " }";
+        }
+        else
+        {
+            stream << "leaf,";
+            DatumCoordWriter< Coord >::write( stream, "." );
+            stream << ",,," << count << "\n";
+        }
+    }
+
+    T_Heatmap const & heatmap;
+    std::ostream & stream;
+    bool const json;
+};
+
+} // namespace internal
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory. For
+ *  the interface details see \ref Factory. It forwards everything to another
+ *  mapping, but counts every access (every call of `getBlobByte`,
+ *  `getArrayBlobByte` or `compute`) per leaf and, for leaves with storage, per
+ *  cache line of every blob, e.g. to see which leaves and memory regions a
+ *  kernel really touches before choosing a layout. The counters are atomic and
+ *  shared by all copies of the mapping (e.g. the one inside the view), so views
+ *  may be used by several threads. As the counters live in host memory, the
+ *  mapping can only be used on the host. The counts can be written as CSV with
+ *  \ref writeCsv or as JSON with \ref writeJson.
+ * \tparam T_Mapping mapping to forward to, e.g. \ref SoA or \ref AoS
+ * \tparam T_granularity size of the counted memory regions in byte, e.g. the
+ *  size of a cache line
+ */
+template<
+    typename T_Mapping,
+    std::size_t T_granularity = 64
+>
+struct Heatmap
+{
+    using Mapping = T_Mapping;
+    using UserDomain = typename Mapping::UserDomain;
+    using UserDomainSize = typename Mapping::UserDomainSize;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = typename Mapping::DatumDomain;
+    static constexpr std::size_t blobCount = Mapping::blobCount;
+    static constexpr std::size_t granularity = T_granularity;
+
+    /// forwards whether the mapping computes a leaf on access
+    template< std::size_t... T_datumDomainCoord >
+    using IsComputed = llama::internal::IsComputedLeaf<
+        Mapping,
+        DatumCoord< T_datumDomainCoord... >
+    >;
+
+    /// \param size size of the user domain
+    Heatmap( UserDomainSize const size ) :
+        Heatmap( Mapping( size ) )
+    { }
+
+    /// \param mapping mapping to forward to
+    explicit Heatmap( Mapping const mapping ) :
+        mapping( mapping ),
+        counters( std::make_shared< Counters >( mapping ) )
+    { }
+
+    Heatmap() = default;
+    Heatmap( Heatmap const & ) = default;
+    Heatmap( Heatmap && ) = default;
+    ~Heatmap( ) = default;
+
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return mapping.getBlobSize( blobNr );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        IndexType const byte =
+            mapping.template getBlobByte< T_datumDomainCoord... >( coord );
+        count(
+            LinearLeafIndex<
+                DatumDomain,
+                T_datumDomainCoord...
+            >::value,
+            mapping.template getBlobNr< T_datumDomainCoord... >( coord ),
+            byte,
+            sizeof( GetType<
+                DatumDomain,
+                T_datumDomainCoord...
+            > )
+        );
+        return byte;
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return mapping.template getBlobNr< T_datumDomainCoord... >( coord );
+    }
+
+    /** Forwards the access to a leaf in an element of a \ref DatumArray with
+     *  a run time index (see \ref View::arrayAccessor) if the mapping
+     *  supports it. The access is counted for the real element.
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord,
+        typename T_Inner = Mapping
+    >
+    auto
+    getArrayBlobByte(
+        UserDomain const coord,
+        std::size_t const index,
+        DatumCoord< T_arrayCoord... > const arrayCoord,
+        DatumCoord< T_elementCoord... > const elementCoord
+    ) const
+    -> decltype( std::declval< T_Inner const & >().getArrayBlobByte(
+        coord,
+        index,
+        arrayCoord,
+        elementCoord
+    ) )
+    {
+        using ArrayType = GetType<
+            DatumDomain,
+            T_arrayCoord...
+        >;
+        IndexType const byte = mapping.getArrayBlobByte(
+            coord,
+            index,
+            arrayCoord,
+            elementCoord
+        );
+        count(
+            LinearLeafIndex<
+                DatumDomain,
+                T_arrayCoord...,
+                0,
+                T_elementCoord...
+            >::value
+                + index * ( LeafCount< ArrayType >::value
+                    / boost::mp11::mp_size< ArrayType >::value ),
+            mapping.getArrayBlobNr(
+                coord,
+                index,
+                arrayCoord,
+                elementCoord
+            ),
+            byte,
+            sizeof( GetType<
+                DatumDomain,
+                T_arrayCoord...,
+                0,
+                T_elementCoord...
+            > )
+        );
+        return byte;
+    }
+
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord,
+        typename T_Inner = Mapping
+    >
+    auto
+    getArrayBlobNr(
+        UserDomain const coord,
+        std::size_t const index,
+        DatumCoord< T_arrayCoord... > const arrayCoord,
+        DatumCoord< T_elementCoord... > const elementCoord
+    ) const
+    -> decltype( std::declval< T_Inner const & >().getArrayBlobNr(
+        coord,
+        index,
+        arrayCoord,
+        elementCoord
+    ) )
+    {
+        return mapping.getArrayBlobNr(
+            coord,
+            index,
+            arrayCoord,
+            elementCoord
+        );
+    }
+
+    /** Forwards the access to a leaf computed by the mapping. Only the leaf
+     *  access is counted, as the touched memory depends on the mapping.
+     */
+    template<
+        std::size_t... T_datumDomainCoord,
+        typename T_Blobs
+    >
+    auto
+    compute(
+        UserDomain const coord,
+        T_Blobs & blobs
+    ) const
+    -> decltype( std::declval< Mapping const & >().template compute<
+        T_datumDomainCoord...
+    >( coord, blobs ) )
+    {
+        countLeaf( LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value );
+        return mapping.template compute< T_datumDomainCoord... >(
+            coord,
+            blobs
+        );
+    }
+
+    /** Gives the number of accesses of a leaf.
+     * \param leafIndex index of the leaf in the flattened datum domain
+     * \return number of accesses
+     */
+    auto
+    leafAccesses( std::size_t const leafIndex ) const
+    -> std::size_t
+    {
+        return counters->leaves[ leafIndex ].load( std::memory_order_relaxed );
+    }
+
+    /** Gives the number of accesses of a memory region.
+     * \param blobNr number of the blob
+     * \param line index of the region of `granularity` bytes in the blob
+     * \return number of accesses touching the region
+     */
+    auto
+    lineAccesses(
+        std::size_t const blobNr,
+        std::size_t const line
+    ) const
+    -> std::size_t
+    {
+        return counters->lines[ counters->lineOffsets[ blobNr ] + line ].load(
+            std::memory_order_relaxed
+        );
+    }
+
+    /// sets all counters to zero
+    auto
+    reset() const
+    -> void
+    {
+        for ( auto & counter : counters->leaves )
+            counter.store( 0, std::memory_order_relaxed );
+        for ( auto & counter : counters->lines )
+            counter.store( 0, std::memory_order_relaxed );
+    }
+
+    /** Writes the counts as CSV with the columns `kind,leaf,blob,byte,accesses`.
+     *  Every leaf gives a row `leaf,<coord>,,,<accesses>` with the
+     *  \ref DatumCoord separated by dots and every memory region a row
+     *  `line,,<blob>,<first byte>,<accesses>`.
+     * \param stream stream to write to
+     */
+    auto
+    writeCsv( std::ostream & stream ) const
+    -> void
+    {
+        stream << "kind,leaf,blob,byte,accesses\n";
+        boost::mp11::mp_for_each< boost::mp11::mp_iota_c<
+            LeafCount< DatumDomain >::value
+        > >( internal::HeatmapLeafWriter< Heatmap >{
+            *this,
+            stream,
+            false
+        } );
+        for ( std::size_t nr = 0; nr < blobCount; ++nr )
+            for ( std::size_t line = 0; line < lineCount( nr ); ++line )
+                stream << "line,," << nr << ',' << line * granularity << ','
+                    << lineAccesses( nr, line ) << '\n';
+    }
+
+    /** Writes the counts as JSON object with the granularity, an array
+     *  `leaves` of objects with the \ref DatumCoord and the accesses of every
+     *  leaf and an array `blobs` with an array of accesses per memory region
+     *  for every blob.
+     * \param stream stream to write to
+     */
+    auto
+    writeJson( std::ostream & stream ) const
+    -> void
+    {
+        stream << "{\n  \"granularity\": " << granularity
+            << ",\n  \"leaves\": [";
+        boost::mp11::mp_for_each< boost::mp11::mp_iota_c<
+            LeafCount< DatumDomain >::value
+        > >( internal::HeatmapLeafWriter< Heatmap >{
+            *this,
+            stream,
+            true
+        } );
+        stream << "\n  ],\n  \"blobs\": [";
+        for ( std::size_t nr = 0; nr < blobCount; ++nr )
+        {
+            stream << ( nr == 0 ? "" : "," ) << "\n    [";
+            for ( std::size_t line = 0; line < lineCount( nr ); ++line )
+                stream << ( line == 0 ? "" : ", " )
+                    << lineAccesses( nr, line );
+            stream << "]";
+        }
+        stream << "\n  ]\n}\n";
+    }
+
+    /// number of memory regions of `granularity` bytes of a blob
+    auto
+    lineCount( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return counters->lineOffsets[ blobNr + 1 ]
+            - counters->lineOffsets[ blobNr ];
+    }
+
+    Mapping const mapping;
+
+private:
+    struct Counters
+    {
+        Counters( Mapping const & mapping ) :
+            leaves( LeafCount< DatumDomain >::value ),
+            lineOffsets( offsets( mapping ) ),
+            lines( lineOffsets[ blobCount ] )
+        { }
+
+        static
+        auto
+        offsets( Mapping const & mapping )
+        -> std::vector< std::size_t >
+        {
+            std::vector< std::size_t > result( blobCount + 1, 0 );
+            for ( std::size_t nr = 0; nr < blobCount; ++nr )
+                result[ nr + 1 ] = result[ nr ]
+                    + ( mapping.getBlobSize( nr ) + granularity - 1 )
+                    / granularity;
+            return result;
+        }
+
+        std::vector< std::atomic< std::size_t > > leaves;
+        /// first memory region of every blob in `lines` and their total count
+        std::vector< std::size_t > const lineOffsets;
+        std::vector< std::atomic< std::size_t > > lines;
+    };
+
+    auto
+    countLeaf( std::size_t const leafIndex ) const
+    -> void
+    {
+        counters->leaves[ leafIndex ].fetch_add(
+            1,
+            std::memory_order_relaxed
+        );
+    }
+
+    /// counts an access of a leaf and of the memory regions it covers
+    auto
+    count(
+        std::size_t const leafIndex,
+        std::size_t const nr,
+        std::size_t const byte,
+        std::size_t const size
+    ) const
+    -> void
+    {
+        countLeaf( leafIndex );
+        for ( std::size_t line = byte / granularity;
+            line <= ( byte + size - 1 ) / granularity;
+            ++line
+        )
+            counters->lines[ counters->lineOffsets[ nr ] + line ].fetch_add(
+                1,
+                std::memory_order_relaxed
+            );
+    }
+
+    std::shared_ptr< Counters > counters;
+};
+
+} // namespace mapping
+
+} // namespace llama
@@ -0,0 +1,204 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+namespace internal
+{
+
+template<
+    typename T_DatumDomain,
+    typename... T_DatumCoords
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+leafSizesHelper( boost::mp11::mp_list< T_DatumCoords... > )
+-> Array<
+    std::size_t,
+    sizeof...( T_DatumCoords )
+>
+{
+    return Array<
+        std::size_t,
+        sizeof...( T_DatumCoords )
+    >{ sizeof( GetTypeFromDatumCoord<
+        T_DatumDomain,
+        T_DatumCoords
+    > )... };
+}
+
+} // namespace internal
+
+/** Struct of array mapping which can be used for creating a \ref View with a
+ *  \ref Factory. For the interface details see \ref Factory. Unlike \ref SoA
+ *  every leaf of the datum domain gets its own blob, so the arrays of the
+ *  leaves can be allocated, aligned and copied independently. The blob number
+ *  of a leaf is its \ref LinearLeafIndex.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_LinearizeUserDomainAdressFunctor Defines how the user domain should
+ *  be linearized, e.g. C like with the last dimension being the "fast" one
+ *  (\ref LinearizeUserDomainAdress, default) or Fortran like with the first
+ *  dimension being the "fast" one (\ref LinearizeUserDomainAdressLikeFortran).
+ * \tparam T_ExtentUserDomainAdressFunctor Defines how the size of the view
+ *  shall be created. Should fit for `T_LinearizeUserDomainAdressFunctor`. Only
+ *  right now implemented and default value is \ref ExtentUserDomainAdress.
+ * \see SoA
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_LinearizeUserDomainAdressFunctor =
+        LinearizeUserDomainAdress< T_UserDomain::count >,
+    typename T_ExtentUserDomainAdressFunctor =
+        ExtentUserDomainAdress< T_UserDomain::count >
+>
+struct MultiBlobSoA
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    static constexpr std::size_t blobCount = LeafCount< DatumDomain >::value;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    MultiBlobSoA( UserDomainSize const size ) :
+        userDomainSize( size ),
+        linearizeUserDomainAdress( llama::internal::makeLinearizer<
+            T_LinearizeUserDomainAdressFunctor
+        >( size ) ),
+        extentUserDomainAdress(
+            T_ExtentUserDomainAdressFunctor()( userDomainSize )
+        )
+    {}
+
+    MultiBlobSoA() = default;
+    MultiBlobSoA( MultiBlobSoA const & ) = default;
+    MultiBlobSoA( MultiBlobSoA && ) = default;
+    ~MultiBlobSoA( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return extentUserDomainAdress
+            * internal::leafSizesHelper< DatumDomain >(
+                FlatDatumCoords< DatumDomain >{ }
+            )[ blobNr ];
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return linearizeUserDomainAdress( coord, userDomainSize )
+            * IndexType( sizeof( GetType<
+                DatumDomain,
+                T_datumDomainCoord...
+            > ) );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value;
+    }
+
+    /** Gives the byte position of a leaf in an element of a homogeneous
+     *  \ref DatumArray with the element index given at run time, see
+     *  \ref View::arrayAccessor. Every leaf has its own blob, so all elements
+     *  have the same byte position.
+     * \param coord coordinate in the user domain
+     * \return byte position of the leaf
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getArrayBlobByte(
+        UserDomain const coord,
+        std::size_t const /* index */,
+        DatumCoord< T_arrayCoord... >,
+        DatumCoord< T_elementCoord... >
+    ) const
+    -> IndexType
+    {
+        return getBlobByte< T_arrayCoord..., 0, T_elementCoord... >( coord );
+    }
+
+    /** Gives the blob of a leaf in an element of a homogeneous
+     *  \ref DatumArray with the element index given at run time, see
+     *  \ref View::arrayAccessor.
+     * \param coord coordinate in the user domain
+     * \param index index of the element in the array
+     * \return blob of the leaf
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getArrayBlobNr(
+        UserDomain const coord,
+        std::size_t const index,
+        DatumCoord< T_arrayCoord... >,
+        DatumCoord< T_elementCoord... >
+    ) const
+    -> std::size_t
+    {
+        return getBlobNr< T_arrayCoord..., 0, T_elementCoord... >( coord )
+            + index * ( LeafCount< GetType<
+                DatumDomain,
+                T_arrayCoord...
+            > >::value / boost::mp11::mp_size< GetType<
+                DatumDomain,
+                T_arrayCoord...
+            > >::value );
+    }
+    UserDomainSize const userDomainSize;
+    T_LinearizeUserDomainAdressFunctor const linearizeUserDomainAdress;
+    std::size_t const extentUserDomainAdress;
+};
+
+} // namespace mapping
+
+} // namespace llama
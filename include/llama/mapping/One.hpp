@@ -19,6 +19,7 @@
 #pragma once
 
 #include "../Types.hpp"
+#include "../DatumStruct.hpp"
 #include "../UserDomain.hpp"
 
 namespace llama
@@ -43,10 +44,21 @@ template<
 >
 struct One
 {
-    using UserDomain = T_UserDomain;
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
     using DatumDomain = T_DatumDomain;
     static constexpr std::size_t blobCount = 1;
 
+    One() = default;
+
+    /** The size of the user domain is ignored, but accepted for using the
+     *  mapping inside other mappings like \ref Uniform.
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit One( UserDomainSize const )
+    { }
+
     LLAMA_FN_HOST_ACC_INLINE
     auto
     getBlobSize( std::size_t const ) const
@@ -60,13 +72,12 @@ struct One
     constexpr
     auto
     getBlobByte( UserDomain const coord ) const
-    -> std::size_t
+    -> IndexType
     {
-        return
-            LinearBytePos<
-                DatumDomain,
-                T_datumDomainCoord...
-            >::value;
+        return IndexType( LinearBytePos<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value );
     }
 
     template< std::size_t... T_datumDomainCoord >
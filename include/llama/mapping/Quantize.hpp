@@ -0,0 +1,587 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include <boost/mp11.hpp>
+
+#include "../Array.hpp"
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+#include "../Proxy.hpp"
+#include "Reorder.hpp"
+#include "SoA.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Linear quantization of a floating point value, which is decoded as
+ *  `stored * scale + offset`.
+ */
+struct Quantization
+{
+    double scale;
+    double offset;
+
+    /** Gives the quantization which maps the whole range of an integral
+     *  storage type evenly to a range of values.
+     * \tparam T_Storage integral type stored in memory
+     * \param min value of the smallest stored integer
+     * \param max value of the biggest stored integer
+     * \return quantization
+     */
+    template< typename T_Storage >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    forRange(
+        double const min,
+        double const max
+    )
+    -> Quantization
+    {
+        double const lowest = double( std::numeric_limits< T_Storage >::min() );
+        double const scale = ( max - min )
+            / ( double( std::numeric_limits< T_Storage >::max() ) - lowest );
+        return Quantization{
+            scale,
+            min - lowest * scale
+        };
+    }
+};
+
+/** Declares the integral type and the default value range a floating point
+ *  leaf (or all leaves of a branch) is quantized with for \ref Quantize.
+ * \tparam T_DatumCoord \ref DatumCoord of the leaf or branch, e.g. gotten with
+ *  \ref GetCoordFromUID
+ * \tparam T_StorageType integral type stored in memory, e.g. `std::uint8_t`,
+ *  `std::int16_t` or `std::uint32_t`
+ * \tparam T_Min `std::ratio` with the value of the smallest stored integer
+ * \tparam T_Max `std::ratio` with the value of the biggest stored integer
+ */
+template<
+    typename T_DatumCoord,
+    typename T_StorageType,
+    typename T_Min = std::ratio< 0 >,
+    typename T_Max = std::ratio< 1 >
+>
+struct QuantizedAs
+{
+    static_assert(
+        std::is_integral< T_StorageType >::value,
+        "Leaves can only be quantized to integral types"
+    );
+
+    using DatumCoord = T_DatumCoord;
+    using StorageType = T_StorageType;
+
+    /// quantization for the value range given at compile time
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    quantization()
+    -> Quantization
+    {
+        return Quantization::forRange< StorageType >(
+            double( T_Min::num ) / double( T_Min::den ),
+            double( T_Max::num ) / double( T_Max::den )
+        );
+    }
+};
+
+/** Encodes a value to an integer with a quantization, rounding to nearest and
+ *  saturating at the range of the integral type.
+ * \tparam T_Storage integral type stored in memory
+ * \param value value to encode
+ * \param scale \ref Quantization::scale converted to the type of the value
+ * \param offset \ref Quantization::offset converted to the type of the value
+ * \return stored integer
+ */
+template<
+    typename T_Storage,
+    typename T_Value
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+quantize(
+    T_Value const value,
+    T_Value const scale,
+    T_Value const offset
+)
+-> T_Storage
+{
+    T_Value const lowest = T_Value( std::numeric_limits< T_Storage >::min() );
+    T_Value const highest = T_Value( std::numeric_limits< T_Storage >::max() );
+    T_Value const x = ( value - offset ) / scale;
+    T_Value const rounded = x + ( x < T_Value( 0 ) ?
+        T_Value( -0.5 ) :
+        T_Value( 0.5 ) );
+    T_Value const clamped = rounded > lowest ? rounded : lowest;
+    // converting small integers via int keeps the conversion vectorizable,
+    // the biggest 32 or 64 bit integer may be rounded up as floating point
+    return sizeof( T_Storage ) < sizeof( int ) ?
+        T_Storage( int( clamped < highest ? clamped : highest ) ) :
+        ( clamped >= highest ?
+            std::numeric_limits< T_Storage >::max() :
+            T_Storage( clamped ) );
+}
+
+/** Quantizes an array of values element wise, e.g. to a contiguous leaf of a
+ *  \ref Quantize mapping with a \ref SoA inner mapping. The loop has no
+ *  dependencies between elements, so it can be vectorized.
+ * \param source first of `count` values to encode
+ * \param destination first of `count` stored integers
+ * \param count number of values
+ * \param quantization quantization of the leaf, e.g. gotten with
+ *  \ref Quantize::quantizationOf
+ */
+template<
+    typename T_Value,
+    typename T_Storage
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+quantizeArray(
+    T_Value const * const source,
+    T_Storage * const destination,
+    std::size_t const count,
+    Quantization const quantization
+)
+-> void
+{
+    T_Value const scale = T_Value( quantization.scale );
+    T_Value const offset = T_Value( quantization.offset );
+    LLAMA_INDEPENDENT_DATA
+    for ( std::size_t i = 0; i < count; ++i )
+        destination[ i ] = quantize< T_Storage >(
+            source[ i ],
+            scale,
+            offset
+        );
+}
+
+/** Decodes an array of quantized integers element wise, e.g. from a
+ *  contiguous leaf of a \ref Quantize mapping with a \ref SoA inner mapping.
+ *  The loop has no dependencies between elements, so it can be vectorized.
+ * \param source first of `count` stored integers
+ * \param destination first of `count` decoded values
+ * \param count number of values
+ * \param quantization quantization of the leaf, e.g. gotten with
+ *  \ref Quantize::quantizationOf
+ */
+template<
+    typename T_Storage,
+    typename T_Value
+>
+LLAMA_FN_HOST_ACC_INLINE
+auto
+dequantizeArray(
+    T_Storage const * const source,
+    T_Value * const destination,
+    std::size_t const count,
+    Quantization const quantization
+)
+-> void
+{
+    T_Value const scale = T_Value( quantization.scale );
+    T_Value const offset = T_Value( quantization.offset );
+    LLAMA_INDEPENDENT_DATA
+    for ( std::size_t i = 0; i < count; ++i )
+        destination[ i ] = T_Value( source[ i ] ) * scale + offset;
+}
+
+/** Proxy reference to a value of \ref Quantize, which decodes the stored
+ *  integer on reading and encodes the value on writing.
+ * \tparam T_Value type of the leaf
+ * \tparam T_Storage integral type stored in memory
+ */
+template<
+    typename T_Value,
+    typename T_Storage
+>
+struct QuantizedRef : ProxyRefOpMixin<
+    QuantizedRef<
+        T_Value,
+        T_Storage
+    >,
+    T_Value
+>
+{
+    static_assert(
+        std::is_floating_point< T_Value >::value,
+        "Only floating point leaves can be quantized"
+    );
+
+    /**
+     * \param bytes first byte of the stored integer
+     * \param quantization quantization of the leaf
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    QuantizedRef(
+        unsigned char * const bytes,
+        Quantization const quantization
+    ) :
+        bytes( bytes ),
+        scale( T_Value( quantization.scale ) ),
+        offset( T_Value( quantization.offset ) )
+    { }
+
+    QuantizedRef( QuantizedRef const & ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    operator T_Value() const
+    {
+        T_Storage stored;
+        std::memcpy( &stored, bytes, sizeof( T_Storage ) );
+        return T_Value( stored ) * scale + offset;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator=( T_Value const value )
+    -> QuantizedRef &
+    {
+        T_Storage const stored = quantize< T_Storage >(
+            value,
+            scale,
+            offset
+        );
+        std::memcpy( bytes, &stored, sizeof( T_Storage ) );
+        return *this;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator=( QuantizedRef const & other )
+    -> QuantizedRef &
+    {
+        return *this = T_Value( other );
+    }
+
+    /// first byte of the stored integer
+    unsigned char * const bytes;
+    T_Value const scale;
+    T_Value const offset;
+};
+
+namespace internal
+{
+
+template< typename T_DatumCoord >
+struct IsQuantizedAsOf
+{
+    template< typename T_QuantizedAs >
+    using fn = IsPrefixOf<
+        typename T_QuantizedAs::DatumCoord,
+        T_DatumCoord
+    >;
+};
+
+template<
+    typename T_DatumDomain,
+    typename T_Quantizations
+>
+struct QuantizedLeaf
+{
+    /** index of the matching \ref QuantizedAs or the number of them for not
+     *  quantized leaves
+     */
+    template< typename T_LeafIndex >
+    using Index = boost::mp11::mp_find_if<
+        T_Quantizations,
+        IsQuantizedAsOf< boost::mp11::mp_at<
+            FlatDatumCoords< T_DatumDomain >,
+            T_LeafIndex
+        > >::template fn
+    >;
+
+    template< typename T_LeafIndex >
+    using IsQuantized = boost::mp11::mp_bool< Index< T_LeafIndex >::value
+        < boost::mp11::mp_size< T_Quantizations >::value >;
+
+    template< typename T_LeafIndex >
+    using StorageType = typename boost::mp11::mp_eval_if_c<
+        !IsQuantized< T_LeafIndex >::value,
+        QuantizedAs<
+            DatumCoord< >,
+            char
+        >,
+        boost::mp11::mp_at,
+        T_Quantizations,
+        Index< T_LeafIndex >
+    >::StorageType;
+
+    template< typename T_LeafIndex >
+    using fn = DatumElement<
+        T_LeafIndex,
+        boost::mp11::mp_eval_if_c<
+            !IsQuantized< T_LeafIndex >::value,
+            LeafTypeAt<
+                T_DatumDomain,
+                T_LeafIndex
+            >,
+            StorageType,
+            T_LeafIndex
+        >
+    >;
+};
+
+} // namespace internal
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory.
+ *  For the interface details see \ref Factory. Selected floating point leaves
+ *  with a bounded range, e.g. positions in a box or normalized colors, are
+ *  stored as 8, 16 or 32 bit integers with a linear \ref Quantization. The
+ *  view returns a proxy reference (\ref QuantizedRef) for them, which decodes
+ *  and encodes on every access, but `auto` variables initialized with it keep
+ *  referring to the memory. The quantizations default to the value ranges
+ *  given at compile time with \ref QuantizedAs and can be given at run time
+ *  for every mapping and thus every view. All leaves are laid out by an inner
+ *  mapping as flat datum domain of the stored types in their original order,
+ *  so e.g. with \ref SoA a whole leaf can be encoded or decoded at once with
+ *  \ref quantizeArray and \ref dequantizeArray.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_Quantizations `boost::mp11::mp_list` of \ref QuantizedAs with the
+ *  storage types and value ranges of the selected leaves or branches. The
+ *  first matching entry counts.
+ * \tparam T_InnerMapping mapping template taking a user domain and a datum
+ *  domain used for the stored leaves, e.g. \ref SoA (default) or \ref AoS
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_Quantizations,
+    template< typename... > class T_InnerMapping = SoA
+>
+struct Quantize
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    using Quantizations = T_Quantizations;
+    /// flat datum domain of the leaves with their storage types
+    using StoredDatumDomain = boost::mp11::mp_transform<
+        internal::QuantizedLeaf<
+            DatumDomain,
+            Quantizations
+        >::template fn,
+        internal::LeafIndices< DatumDomain >
+    >;
+    using InnerMapping = T_InnerMapping<
+        UserDomainSize,
+        StoredDatumDomain
+    >;
+    static constexpr std::size_t blobCount = InnerMapping::blobCount;
+    /// run time quantizations in the order of \ref QuantizedAs entries
+    using QuantizationArray = Array<
+        Quantization,
+        boost::mp11::mp_size< Quantizations >::value
+    >;
+
+    /** Tells the \ref View that quantized leaves are not addressable and need
+     *  to be accessed with \ref compute.
+     */
+    template< std::size_t... T_datumDomainCoord >
+    using IsComputed = typename internal::QuantizedLeaf<
+        DatumDomain,
+        Quantizations
+    >::template IsQuantized< boost::mp11::mp_size_t< LinearLeafIndex<
+        DatumDomain,
+        T_datumDomainCoord...
+    >::value > >;
+
+    /** Uses the value ranges given at compile time.
+     * \param size size of the user domain
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    Quantize( UserDomainSize const size ) :
+        userDomainSize( size ),
+        innerMapping( size ),
+        quantizations( defaultQuantizations() )
+    { }
+
+    /**
+     * \param size size of the user domain
+     * \param quantizations quantization for every \ref QuantizedAs entry,
+     *  e.g. created with \ref Quantization::forRange
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    Quantize(
+        UserDomainSize const size,
+        QuantizationArray const quantizations
+    ) :
+        userDomainSize( size ),
+        innerMapping( size ),
+        quantizations( quantizations )
+    { }
+
+    Quantize() = default;
+    Quantize( Quantize const & ) = default;
+    Quantize( Quantize && ) = default;
+    ~Quantize( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return innerMapping.getBlobSize( blobNr );
+    }
+
+    /** For quantized leaves the first byte of the stored integer */
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return innerMapping.template getBlobByte< LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value >( coord );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return innerMapping.template getBlobNr< LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value >( coord );
+    }
+
+    /// quantization of a quantized leaf
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    quantizationOf() const
+    -> Quantization
+    {
+        return quantizations[ internal::QuantizedLeaf<
+            DatumDomain,
+            Quantizations
+        >::template Index< boost::mp11::mp_size_t< LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value > >::value ];
+    }
+
+    /** Gives the proxy reference to a quantized leaf.
+     * \param coord coordinate in the user domain
+     * \param blobs blobs of the view
+     * \return \ref QuantizedRef to the value
+     */
+    template<
+        std::size_t... T_datumDomainCoord,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    compute(
+        UserDomain const coord,
+        T_Blobs & blobs
+    ) const
+    -> QuantizedRef<
+        GetType<
+            DatumDomain,
+            T_datumDomainCoord...
+        >,
+        typename internal::QuantizedLeaf<
+            DatumDomain,
+            Quantizations
+        >::template StorageType< boost::mp11::mp_size_t< LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value > >
+    >
+    {
+        return QuantizedRef<
+            GetType<
+                DatumDomain,
+                T_datumDomainCoord...
+            >,
+            typename internal::QuantizedLeaf<
+                DatumDomain,
+                Quantizations
+            >::template StorageType< boost::mp11::mp_size_t< LinearLeafIndex<
+                DatumDomain,
+                T_datumDomainCoord...
+            >::value > >
+        >(
+            reinterpret_cast< unsigned char * >( &blobs[
+                getBlobNr< T_datumDomainCoord... >( coord )
+            ][
+                getBlobByte< T_datumDomainCoord... >( coord )
+            ] ),
+            quantizationOf< T_datumDomainCoord... >()
+        );
+    }
+
+    UserDomainSize const userDomainSize;
+    InnerMapping const innerMapping;
+    QuantizationArray const quantizations;
+
+private:
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    defaultQuantizations()
+    -> QuantizationArray
+    {
+        QuantizationArray result;
+        boost::mp11::mp_for_each< boost::mp11::mp_iota<
+            boost::mp11::mp_size< Quantizations >
+        > >( DefaultQuantizationFunctor{ result } );
+        return result;
+    }
+
+    struct DefaultQuantizationFunctor
+    {
+        QuantizationArray & result;
+
+        template< typename T_Index >
+        LLAMA_FN_HOST_ACC_INLINE
+        auto
+        operator()( T_Index const )
+        -> void
+        {
+            result[ T_Index::value ] = boost::mp11::mp_at<
+                Quantizations,
+                T_Index
+            >::quantization();
+        }
+    };
+};
+
+} // namespace mapping
+
+} // namespace llama
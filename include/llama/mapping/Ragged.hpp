@@ -0,0 +1,181 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../Types.hpp"
+#include "../UserDomain.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory for
+ *  groups of different sizes, e.g. particles per cell or neighbours per
+ *  particle. For the interface details see \ref Factory. The two dimensional
+ *  user domain is (group, index in the group) and like for a compressed
+ *  sparse row matrix a run time offsets array gives the first datum of every
+ *  group. The datums of all groups are stored one after another by an inner
+ *  mapping with a one dimensional user domain, so groups are contiguous in
+ *  memory for e.g. \ref SoA or \ref AoS.
+ * \tparam T_UserDomain type of the two dimensional user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_InnerMapping mapping template taking a user domain and a datum
+ *  domain used to lay out the datums of all groups, e.g. \ref SoA or
+ *  \ref AoS. Mappings with further non-type template parameters can be given
+ *  with an alias template.
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    template< typename... > class T_InnerMapping
+>
+struct Ragged
+{
+    static_assert(
+        T_UserDomain::count == 2,
+        "The user domain of a ragged mapping is (group, index in the group)"
+    );
+
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    using InnerMapping = T_InnerMapping<
+        llama::UserDomain<
+            1,
+            IndexType
+        >,
+        DatumDomain
+    >;
+    static constexpr std::size_t blobCount = InnerMapping::blobCount;
+
+    /** The offsets array is not copied, so it needs to stay valid and
+     *  unchanged as long as the mapping (or a view of it) is used.
+     * \param offsets array of `groupCount + 1` ascending values with the
+     *  first datum of every group and the total number of datums at the end
+     * \param groupCount number of groups
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    Ragged(
+        IndexType const * const offsets,
+        std::size_t const groupCount
+    ) :
+        userDomainSize( UserDomain{
+            IndexType( groupCount ),
+            maxGroupSize( offsets, groupCount )
+        } ),
+        innerMapping( llama::UserDomain<
+            1,
+            IndexType
+        >{ offsets[ groupCount ] } ),
+        offsets( offsets )
+    { }
+
+    Ragged() = default;
+    Ragged( Ragged const & ) = default;
+    Ragged( Ragged && ) = default;
+    ~Ragged( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return innerMapping.getBlobSize( blobNr );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return innerMapping.template getBlobByte< T_datumDomainCoord... >(
+            flat( coord )
+        );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return innerMapping.template getBlobNr< T_datumDomainCoord... >(
+            flat( coord )
+        );
+    }
+
+    /** Gives the number of datums in a group.
+     * \param group number of the group
+     * \return size of the group
+     */
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    groupSize( IndexType const group ) const
+    -> IndexType
+    {
+        return offsets[ group + 1 ] - offsets[ group ];
+    }
+
+    /** Size of the user domain as number of groups and size of the biggest
+     *  group.
+     */
+    UserDomainSize const userDomainSize;
+    InnerMapping const innerMapping;
+    /// first datum of every group and the total number of datums at the end
+    IndexType const * const offsets;
+
+private:
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    maxGroupSize(
+        IndexType const * const offsets,
+        std::size_t const groupCount
+    )
+    -> IndexType
+    {
+        IndexType result = 0;
+        for ( std::size_t i = 0; i < groupCount; ++i )
+            if ( offsets[ i + 1 ] - offsets[ i ] > result )
+                result = offsets[ i + 1 ] - offsets[ i ];
+        return result;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    flat( UserDomain const & coord ) const
+    -> llama::UserDomain<
+        1,
+        IndexType
+    >
+    {
+        return llama::UserDomain<
+            1,
+            IndexType
+        >{ offsets[ coord[ 0 ] ] + coord[ 1 ] };
+    }
+};
+
+} // namespace mapping
+
+} // namespace llama
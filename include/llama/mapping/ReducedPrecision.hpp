@@ -0,0 +1,334 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+#include "../Proxy.hpp"
+#include "../HalfFloat.hpp"
+#include "Reorder.hpp"
+#include "SoA.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Declares the type a leaf (or all leaves of a branch) is stored as in
+ *  memory for \ref ReducedPrecision, e.g. \ref Half, \ref BFloat16 or `float`
+ *  for a `double` leaf.
+ * \tparam T_DatumCoord \ref DatumCoord of the leaf or branch, e.g. gotten with
+ *  \ref GetCoordFromUID
+ * \tparam T_StorageType type stored in memory, which needs to be explicitly
+ *  convertible from and to the type of the leaf
+ */
+template<
+    typename T_DatumCoord,
+    typename T_StorageType
+>
+struct StoredAs
+{
+    using DatumCoord = T_DatumCoord;
+    using StorageType = T_StorageType;
+};
+
+/** Proxy reference to a value of \ref ReducedPrecision, which converts the
+ *  stored value to the type of the leaf on reading and back on writing.
+ * \tparam T_Value type of the leaf
+ * \tparam T_Storage type stored in memory
+ */
+template<
+    typename T_Value,
+    typename T_Storage
+>
+struct ConvertingRef : ProxyRefOpMixin<
+    ConvertingRef<
+        T_Value,
+        T_Storage
+    >,
+    T_Value
+>
+{
+    /// \param bytes first byte of the stored value
+    LLAMA_FN_HOST_ACC_INLINE
+    explicit ConvertingRef( unsigned char * const bytes ) :
+        bytes( bytes )
+    { }
+
+    ConvertingRef( ConvertingRef const & ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    operator T_Value() const
+    {
+        T_Storage stored;
+        std::memcpy( &stored, bytes, sizeof( T_Storage ) );
+        return static_cast< T_Value >( stored );
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator=( T_Value const value )
+    -> ConvertingRef &
+    {
+        T_Storage const stored = static_cast< T_Storage >( value );
+        std::memcpy( bytes, &stored, sizeof( T_Storage ) );
+        return *this;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    operator=( ConvertingRef const & other )
+    -> ConvertingRef &
+    {
+        return *this = T_Value( other );
+    }
+
+    /// first byte of the stored value
+    unsigned char * const bytes;
+};
+
+namespace internal
+{
+
+template< typename T_DatumCoord >
+struct IsStoredAsOf
+{
+    template< typename T_StoredAs >
+    using fn = IsPrefixOf<
+        typename T_StoredAs::DatumCoord,
+        T_DatumCoord
+    >;
+};
+
+template<
+    typename T_DatumDomain,
+    typename T_Replacements
+>
+struct StoredLeafType
+{
+    template< typename T_LeafIndex >
+    using Index = boost::mp11::mp_find_if<
+        T_Replacements,
+        IsStoredAsOf< boost::mp11::mp_at<
+            FlatDatumCoords< T_DatumDomain >,
+            T_LeafIndex
+        > >::template fn
+    >;
+
+    template< typename T_LeafIndex >
+    using fn = typename boost::mp11::mp_eval_if_c<
+        Index< T_LeafIndex >::value
+            == boost::mp11::mp_size< T_Replacements >::value,
+        StoredAs<
+            DatumCoord< >,
+            LeafTypeAt<
+                T_DatumDomain,
+                T_LeafIndex
+            >
+        >,
+        boost::mp11::mp_at,
+        T_Replacements,
+        Index< T_LeafIndex >
+    >::StorageType;
+};
+
+template<
+    typename T_DatumDomain,
+    typename T_Replacements
+>
+struct StoredDatumElement
+{
+    template< typename T_LeafIndex >
+    using fn = DatumElement<
+        T_LeafIndex,
+        typename StoredLeafType<
+            T_DatumDomain,
+            T_Replacements
+        >::template fn< T_LeafIndex >
+    >;
+};
+
+} // namespace internal
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory.
+ *  For the interface details see \ref Factory. Selected leaves are stored in
+ *  memory with a smaller type, e.g. a `float` as \ref Half or \ref BFloat16
+ *  or a `double` as `float`, to reduce the memory footprint and traffic. The
+ *  view returns a proxy reference (\ref ConvertingRef) for them, which
+ *  converts on every access, but `auto` variables initialized with it keep
+ *  referring to the memory. All leaves are laid out by an inner mapping as
+ *  flat datum domain of the stored types in their original order, so e.g.
+ *  with \ref SoA a whole leaf can be converted at once with
+ *  \ref convertArray.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_Replacements `boost::mp11::mp_list` of \ref StoredAs with the
+ *  storage types of the selected leaves or branches. The first matching entry
+ *  counts.
+ * \tparam T_InnerMapping mapping template taking a user domain and a datum
+ *  domain used for the stored leaves, e.g. \ref SoA (default) or \ref AoS
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_Replacements,
+    template< typename... > class T_InnerMapping = SoA
+>
+struct ReducedPrecision
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    using Replacements = T_Replacements;
+    /// flat datum domain of the leaves with their storage types
+    using StoredDatumDomain = boost::mp11::mp_transform<
+        internal::StoredDatumElement<
+            DatumDomain,
+            Replacements
+        >::template fn,
+        internal::LeafIndices< DatumDomain >
+    >;
+    using InnerMapping = T_InnerMapping<
+        UserDomainSize,
+        StoredDatumDomain
+    >;
+    static constexpr std::size_t blobCount = InnerMapping::blobCount;
+
+    /// type a leaf is stored as in memory
+    template< std::size_t... T_datumDomainCoord >
+    using StorageType = typename internal::StoredLeafType<
+        DatumDomain,
+        Replacements
+    >::template fn< boost::mp11::mp_size_t< LinearLeafIndex<
+        DatumDomain,
+        T_datumDomainCoord...
+    >::value > >;
+
+    /** Tells the \ref View that leaves with a different storage type are not
+     *  addressable and need to be accessed with \ref compute.
+     */
+    template< std::size_t... T_datumDomainCoord >
+    using IsComputed = boost::mp11::mp_bool< !std::is_same<
+        StorageType< T_datumDomainCoord... >,
+        GetType<
+            DatumDomain,
+            T_datumDomainCoord...
+        >
+    >::value >;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    ReducedPrecision( UserDomainSize const size ) :
+        userDomainSize( size ),
+        innerMapping( size )
+    { }
+
+    ReducedPrecision() = default;
+    ReducedPrecision( ReducedPrecision const & ) = default;
+    ReducedPrecision( ReducedPrecision && ) = default;
+    ~ReducedPrecision( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return innerMapping.getBlobSize( blobNr );
+    }
+
+    /** For leaves with a different storage type the first byte of the stored
+     *  value
+     */
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return innerMapping.template getBlobByte< LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value >( coord );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return innerMapping.template getBlobNr< LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value >( coord );
+    }
+
+    /** Gives the converting proxy reference to a leaf with a different
+     *  storage type.
+     * \param coord coordinate in the user domain
+     * \param blobs blobs of the view
+     * \return \ref ConvertingRef to the value
+     */
+    template<
+        std::size_t... T_datumDomainCoord,
+        typename T_Blobs
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    compute(
+        UserDomain const coord,
+        T_Blobs & blobs
+    ) const
+    -> ConvertingRef<
+        GetType<
+            DatumDomain,
+            T_datumDomainCoord...
+        >,
+        StorageType< T_datumDomainCoord... >
+    >
+    {
+        return ConvertingRef<
+            GetType<
+                DatumDomain,
+                T_datumDomainCoord...
+            >,
+            StorageType< T_datumDomainCoord... >
+        >(
+            reinterpret_cast< unsigned char * >( &blobs[
+                getBlobNr< T_datumDomainCoord... >( coord )
+            ][
+                getBlobByte< T_datumDomainCoord... >( coord )
+            ] )
+        );
+    }
+
+    UserDomainSize const userDomainSize;
+    InnerMapping const innerMapping;
+};
+
+} // namespace mapping
+
+} // namespace llama
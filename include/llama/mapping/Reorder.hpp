@@ -0,0 +1,323 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+namespace internal
+{
+
+template<
+    typename T_DatumDomain,
+    typename T_LeafIndex
+>
+using LeafTypeAt = GetTypeFromDatumCoord<
+    T_DatumDomain,
+    boost::mp11::mp_at<
+        FlatDatumCoords< T_DatumDomain >,
+        T_LeafIndex
+    >
+>;
+
+template< typename T_DatumDomain >
+using LeafIndices = boost::mp11::mp_iota_c<
+    LeafCount< T_DatumDomain >::value
+>;
+
+template<
+    typename T_DatumDomain,
+    template< typename > class T_Key
+>
+struct StableDescendingByKey
+{
+    template<
+        typename T_LeafIndexA,
+        typename T_LeafIndexB
+    >
+    using fn = boost::mp11::mp_bool<
+        ( T_Key< LeafTypeAt< T_DatumDomain, T_LeafIndexA > >::value >
+            T_Key< LeafTypeAt< T_DatumDomain, T_LeafIndexB > >::value ) ||
+        ( T_Key< LeafTypeAt< T_DatumDomain, T_LeafIndexA > >::value ==
+            T_Key< LeafTypeAt< T_DatumDomain, T_LeafIndexB > >::value &&
+            T_LeafIndexA::value < T_LeafIndexB::value )
+    >;
+};
+
+template< typename T_Leaf >
+using AlignOfLeaf = std::integral_constant<
+    std::size_t,
+    alignof( T_Leaf )
+>;
+
+template< typename T_Leaf >
+using SizeOfLeaf = std::integral_constant<
+    std::size_t,
+    sizeof( T_Leaf )
+>;
+
+template<
+    typename T_Prefix,
+    typename T_DatumCoord
+>
+using IsPrefixOf = boost::mp11::mp_bool<
+    ( T_Prefix::size <= T_DatumCoord::size ) &&
+    DatumCoordIsSame<
+        T_Prefix,
+        T_DatumCoord
+    >::value
+>;
+
+template< typename T_DatumCoord >
+struct IsPrefixOfCoord
+{
+    template< typename T_Prefix >
+    using fn = IsPrefixOf<
+        T_Prefix,
+        T_DatumCoord
+    >;
+};
+
+template<
+    typename T_DatumCoord,
+    typename... T_Priorities
+>
+using PriorityRank = boost::mp11::mp_find_if<
+    boost::mp11::mp_list< T_Priorities... >,
+    IsPrefixOfCoord< T_DatumCoord >::template fn
+>;
+
+template<
+    typename T_DatumDomain,
+    typename... T_Priorities
+>
+struct AscendingByPriority
+{
+    template< typename T_LeafIndex >
+    using Rank = PriorityRank<
+        boost::mp11::mp_at<
+            FlatDatumCoords< T_DatumDomain >,
+            T_LeafIndex
+        >,
+        T_Priorities...
+    >;
+
+    template<
+        typename T_LeafIndexA,
+        typename T_LeafIndexB
+    >
+    using fn = boost::mp11::mp_bool<
+        ( Rank< T_LeafIndexA >::value < Rank< T_LeafIndexB >::value ) ||
+        ( Rank< T_LeafIndexA >::value == Rank< T_LeafIndexB >::value &&
+            T_LeafIndexA::value < T_LeafIndexB::value )
+    >;
+};
+
+template< typename T_DatumDomain >
+struct PermutedDatumElement
+{
+    template< typename T_LeafIndex >
+    using fn = DatumElement<
+        T_LeafIndex,
+        LeafTypeAt<
+            T_DatumDomain,
+            T_LeafIndex
+        >
+    >;
+};
+
+} // namespace internal
+
+/// Order policy for \ref Reorder keeping the original order of the leaves.
+struct KeepOrder
+{
+    template< typename T_DatumDomain >
+    using Permutation = internal::LeafIndices< T_DatumDomain >;
+};
+
+/** Order policy for \ref Reorder sorting the leaves by descending alignment,
+ *  which removes all padding between naturally aligned leaves. Leaves with
+ *  the same alignment keep their original order.
+ */
+struct SortByAlignment
+{
+    template< typename T_DatumDomain >
+    using Permutation = boost::mp11::mp_sort<
+        internal::LeafIndices< T_DatumDomain >,
+        internal::StableDescendingByKey<
+            T_DatumDomain,
+            internal::AlignOfLeaf
+        >::template fn
+    >;
+};
+
+/** Order policy for \ref Reorder sorting the leaves by descending size.
+ *  Leaves with the same size keep their original order.
+ */
+struct SortBySize
+{
+    template< typename T_DatumDomain >
+    using Permutation = boost::mp11::mp_sort<
+        internal::LeafIndices< T_DatumDomain >,
+        internal::StableDescendingByKey<
+            T_DatumDomain,
+            internal::SizeOfLeaf
+        >::template fn
+    >;
+};
+
+/** Order policy for \ref Reorder putting the leaves in the order of a user
+ *  given priority list first, e.g. the hot fields of a kernel. Every entry
+ *  is a \ref DatumCoord of a leaf or a whole branch, e.g. gotten with
+ *  \ref GetCoordFromUID. Leaves not part of the list follow in their
+ *  original order.
+ * \tparam T_DatumCoords... \ref DatumCoord of the prioritized leaves or
+ *  branches, highest priority first
+ */
+template< typename... T_DatumCoords >
+struct Priority
+{
+    template< typename T_DatumDomain >
+    using Permutation = boost::mp11::mp_sort<
+        internal::LeafIndices< T_DatumDomain >,
+        internal::AscendingByPriority<
+            T_DatumDomain,
+            T_DatumCoords...
+        >::template fn
+    >;
+};
+
+/** Mapping adaptor which can be used for creating a \ref View with a
+ *  \ref Factory. For the interface details see \ref Factory. The leaves of the
+ *  datum domain are permuted at compile time by an order policy and laid out
+ *  by an inner mapping as flat datum domain in this new order. The datum
+ *  domain of the view stays the original one, so the leaves are still
+ *  addressed by their original UIDs and \ref DatumCoord.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_InnerMapping mapping template taking a user domain and a datum
+ *  domain used to lay out the permuted leaves, e.g. \ref AoS or
+ *  \ref AlignedAoS. Mappings with further non-type template parameters can be
+ *  given with an alias template.
+ * \tparam T_OrderPolicy defines the permutation of the leaves, e.g.
+ *  \ref SortByAlignment (default), \ref SortBySize or \ref Priority
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    template< typename... > class T_InnerMapping,
+    typename T_OrderPolicy = SortByAlignment
+>
+struct Reorder
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    /// permutation of the leaf indices, the first entry is the first leaf
+    using Permutation =
+        typename T_OrderPolicy::template Permutation< DatumDomain >;
+    /// flat datum domain of the permuted leaves given to the inner mapping
+    using PermutedDatumDomain = boost::mp11::mp_transform<
+        internal::PermutedDatumElement< DatumDomain >::template fn,
+        Permutation
+    >;
+    using InnerMapping = T_InnerMapping<
+        UserDomainSize,
+        PermutedDatumDomain
+    >;
+    static constexpr std::size_t blobCount = InnerMapping::blobCount;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    Reorder( UserDomainSize const size ) :
+        userDomainSize( size ),
+        innerMapping( size )
+    { }
+
+    Reorder() = default;
+    Reorder( Reorder const & ) = default;
+    Reorder( Reorder && ) = default;
+    ~Reorder( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return innerMapping.getBlobSize( blobNr );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return innerMapping.template getBlobByte< permutedIndex<
+            T_datumDomainCoord...
+        >() >( coord );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return innerMapping.template getBlobNr< permutedIndex<
+            T_datumDomainCoord...
+        >() >( coord );
+    }
+
+    UserDomainSize const userDomainSize;
+    InnerMapping const innerMapping;
+
+private:
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    constexpr
+    auto
+    permutedIndex()
+    -> std::size_t
+    {
+        return boost::mp11::mp_find<
+            Permutation,
+            boost::mp11::mp_size_t< LinearLeafIndex<
+                DatumDomain,
+                T_datumDomainCoord...
+            >::value >
+        >::value;
+    }
+};
+
+} // namespace mapping
+
+} // namespace llama
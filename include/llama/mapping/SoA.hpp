@@ -30,7 +30,8 @@ namespace mapping
 
 /** Struct of array mapping which can be used for creating a \ref View with a
  *  \ref Factory. For the interface details see \ref Factory.
- * \tparam T_UserDomain type of the user domain
+ * \tparam T_UserDomain type of the user domain size, e.g. \ref UserDomain or
+ *  \ref StaticUserDomain
  * \tparam T_DatumDomain type of the datum domain
  * \tparam T_LinearizeUserDomainAdressFunctor Defines how the user domain should
  *  be linearized, e.g. C like with the last dimension being the "fast" one
@@ -51,14 +52,20 @@ template<
 >
 struct SoA
 {
-    using UserDomain = T_UserDomain;
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    /// type of the linearized user domain and of the byte offsets in the blob
+    using IndexType = UserDomainIndexType< UserDomain >;
     using DatumDomain = T_DatumDomain;
     static constexpr std::size_t blobCount = 1;
 
     /// \param size size of the user domain
     LLAMA_FN_HOST_ACC_INLINE
-    SoA( UserDomain const size ) :
+    SoA( UserDomainSize const size ) :
         userDomainSize( size ),
+        linearizeUserDomainAdress( llama::internal::makeLinearizer<
+            T_LinearizeUserDomainAdressFunctor
+        >( size ) ),
         extentUserDomainAdress(
             T_ExtentUserDomainAdressFunctor()( userDomainSize )
         )
@@ -81,18 +88,18 @@ struct SoA
     LLAMA_FN_HOST_ACC_INLINE
     auto
     getBlobByte( UserDomain const coord ) const
-    -> std::size_t
+    -> IndexType
     {
-        return T_LinearizeUserDomainAdressFunctor()( coord, userDomainSize )
-            * sizeof( GetType<
+        return linearizeUserDomainAdress( coord, userDomainSize )
+            * IndexType( sizeof( GetType<
                 DatumDomain,
                 T_datumDomainCoord...
-            > )
-            + LinearBytePos<
+            > ) )
+            + IndexType( LinearBytePos<
                 DatumDomain,
                 T_datumDomainCoord...
-            >::value
-            * extentUserDomainAdress;
+            >::value )
+            * IndexType( extentUserDomainAdress );
     }
 
     template< std::size_t... T_datumDomainCoord >
@@ -104,7 +111,61 @@ struct SoA
     {
         return 0;
     }
-    UserDomain const userDomainSize;
+
+    /** Gives the byte position of a leaf in an element of a homogeneous
+     *  \ref DatumArray with the element index given at run time, see
+     *  \ref View::arrayAccessor. The elements are at a constant stride of the
+     *  element size times the extent of the user domain.
+     * \param coord coordinate in the user domain
+     * \param index index of the element in the array
+     * \return byte position of the leaf
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getArrayBlobByte(
+        UserDomain const coord,
+        std::size_t const index,
+        DatumCoord< T_arrayCoord... >,
+        DatumCoord< T_elementCoord... >
+    ) const
+    -> IndexType
+    {
+        return getBlobByte< T_arrayCoord..., 0, T_elementCoord... >( coord )
+            + IndexType( index ) * IndexType( SizeOf< GetType<
+                DatumDomain,
+                T_arrayCoord...,
+                0
+            > >::value * extentUserDomainAdress );
+    }
+
+    /** Gives the blob of a leaf in an element of a homogeneous
+     *  \ref DatumArray with the element index given at run time, see
+     *  \ref View::arrayAccessor. All leaves are in the only blob.
+     * \return blob of the leaf
+     */
+    template<
+        std::size_t... T_arrayCoord,
+        std::size_t... T_elementCoord
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    constexpr
+    auto
+    getArrayBlobNr(
+        UserDomain const /* coord */,
+        std::size_t const /* index */,
+        DatumCoord< T_arrayCoord... >,
+        DatumCoord< T_elementCoord... >
+    ) const
+    -> std::size_t
+    {
+        return 0;
+    }
+    UserDomainSize const userDomainSize;
+    T_LinearizeUserDomainAdressFunctor const linearizeUserDomainAdress;
     std::size_t const extentUserDomainAdress;
 };
 
@@ -0,0 +1,414 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+#include "../Proxy.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+namespace internal
+{
+
+template<
+    std::size_t T_extent,
+    std::size_t T_dim,
+    std::size_t... T_extents
+>
+struct CubicStaticUserDomainImpl
+{
+    using type = typename CubicStaticUserDomainImpl<
+        T_extent,
+        T_dim - 1,
+        T_extent,
+        T_extents...
+    >::type;
+};
+
+template<
+    std::size_t T_extent,
+    std::size_t... T_extents
+>
+struct CubicStaticUserDomainImpl<
+    T_extent,
+    0,
+    T_extents...
+>
+{
+    using type = StaticUserDomain< T_extents... >;
+};
+
+template<
+    std::size_t T_extent,
+    std::size_t T_dim
+>
+using CubicStaticUserDomain =
+    typename CubicStaticUserDomainImpl< T_extent, T_dim >::type;
+
+} // namespace internal
+
+/** Proxy reference to a value of \ref SparseBlockGrid. Reading a value of a
+ *  not activated block gives the background value, writing activates the
+ *  block first. Like \ref SparseBlockGrid::activate it may only be used on
+ *  the host and from one thread at a time.
+ * \tparam T_Mapping type of the \ref SparseBlockGrid
+ * \tparam T_Blobs type of the blob array of the view
+ * \tparam T_coords... coordinate of the leaf in the datum domain
+ */
+template<
+    typename T_Mapping,
+    typename T_Blobs,
+    std::size_t... T_coords
+>
+struct SparseBlockRef : ProxyRefOpMixin<
+    SparseBlockRef<
+        T_Mapping,
+        T_Blobs,
+        T_coords...
+    >,
+    GetType<
+        typename T_Mapping::DatumDomain,
+        T_coords...
+    >
+>
+{
+    using Value = GetType<
+        typename T_Mapping::DatumDomain,
+        T_coords...
+    >;
+
+    /**
+     * \param mapping mapping of the view
+     * \param coord coordinate in the user domain
+     * \param blobs blobs of the view
+     */
+    SparseBlockRef(
+        T_Mapping const & mapping,
+        typename T_Mapping::UserDomain const coord,
+        T_Blobs & blobs
+    ) :
+        mapping( mapping ),
+        coord( coord ),
+        blobs( blobs )
+    { }
+
+    SparseBlockRef( SparseBlockRef const & ) = default;
+
+    operator Value() const
+    {
+        return *address();
+    }
+
+    auto
+    operator=( Value const value )
+    -> SparseBlockRef &
+    {
+        bool const activated = mapping.activate( coord );
+        assert( activated && "Pool of the sparse block grid exhausted" );
+        static_cast< void >( activated );
+        *address() = value;
+        return *this;
+    }
+
+    auto
+    operator=( SparseBlockRef const & other )
+    -> SparseBlockRef &
+    {
+        return *this = Value( other );
+    }
+
+private:
+    auto
+    address() const
+    -> Value *
+    {
+        return reinterpret_cast< Value * >( &blobs[
+            mapping.template getBlobNr< T_coords... >( coord )
+        ][
+            mapping.template getBlobByte< T_coords... >( coord )
+        ] );
+    }
+
+    T_Mapping const & mapping;
+    typename T_Mapping::UserDomain const coord;
+    T_Blobs & blobs;
+};
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory for
+ *  huge, but mostly empty user domains. For the interface details see
+ *  \ref Factory. The user domain is cut into cubic blocks and only a pool of
+ *  `blockCapacity` blocks is allocated. Blocks get a slot in the pool when
+ *  they are activated, either explicitly with \ref activate or by the first
+ *  write to them. A two-level lookup takes the block coordinate to its slot
+ *  via a dense table of one `std::size_t` per block and the coordinate inside
+ *  the block to the byte via a nested mapping. All not activated blocks share
+ *  the background slot in front of the pool, so reading them gives the
+ *  background value. To tell reading and writing apart the view returns a
+ *  proxy reference (\ref SparseBlockRef) for all leaves. Writing to a block
+ *  when the pool is exhausted is only caught by an assertion and would
+ *  change the background for all not activated blocks otherwise, so
+ *  \ref activate should be used to check for this beforehand. Neither the
+ *  background nor newly activated blocks are initialized by the mapping, so
+ *  e.g. the blobs need to be cleared after allocating them.
+ *  The block table is shared by all copies of the mapping and lives in host
+ *  memory, so the view can only be used on the host, and blocks can be
+ *  activated after the view was created, but only from one thread at a
+ *  time.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_BlockMapping mapping template taking a user domain and a datum
+ *  domain used to lay out every block, e.g. \ref AoS, \ref SoA or (with an
+ *  alias template) \ref AoSoA. Its blobs are cut into slots, one per block.
+ * \tparam T_blockExtent edge length of a block in every dimension, best
+ *  chosen as power of two
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    template< typename... > class T_BlockMapping,
+    std::size_t T_blockExtent = 8u
+>
+struct SparseBlockGrid
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    /// nested mapping of one block with static extents
+    using BlockMapping = T_BlockMapping<
+        internal::CubicStaticUserDomain<
+            T_blockExtent,
+            UserDomain::count
+        >,
+        DatumDomain
+    >;
+    static constexpr std::size_t blobCount = BlockMapping::blobCount;
+    /// edge length of a block in every dimension
+    static constexpr std::size_t blockExtent = T_blockExtent;
+
+    /** Tells the \ref View that all leaves need to be accessed with
+     *  \ref compute to activate blocks on writing.
+     */
+    template< std::size_t... T_datumDomainCoord >
+    using IsComputed = boost::mp11::mp_true;
+
+    /**
+     * \param size size of the user domain
+     * \param blockCapacity number of blocks which can be activated at most
+     */
+    SparseBlockGrid(
+        UserDomainSize const size,
+        std::size_t const blockCapacity
+    ) :
+        userDomainSize( size ),
+        blockGridSize( blockGrid( size ) ),
+        blockCapacity( blockCapacity ),
+        blockMapping( typename BlockMapping::UserDomainSize( ) ),
+        blockTableOwner(
+            new std::size_t[ blockCount() + 1 ]( ),
+            std::default_delete< std::size_t[] >( )
+        ),
+        blockTable( blockTableOwner.get() )
+    { }
+
+    SparseBlockGrid() = default;
+    SparseBlockGrid( SparseBlockGrid const & ) = default;
+    SparseBlockGrid( SparseBlockGrid && ) = default;
+    ~SparseBlockGrid( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return ( blockCapacity + 1 ) * blockMapping.getBlobSize( blobNr );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        typename BlockMapping::UserDomain const inBlock =
+            coordInBlock( coord );
+        return IndexType( blockTable[ blockIndex( coord ) ] )
+            * IndexType( blockMapping.getBlobSize(
+                blockMapping.template getBlobNr< T_datumDomainCoord... >(
+                    inBlock
+                )
+            ) )
+            + IndexType( blockMapping.template getBlobByte<
+                T_datumDomainCoord...
+            >( inBlock ) );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return blockMapping.template getBlobNr< T_datumDomainCoord... >(
+            coordInBlock( coord )
+        );
+    }
+
+    /** Gives the proxy reference to a leaf, which activates the block of the
+     *  coordinate on writing.
+     * \param coord coordinate in the user domain
+     * \param blobs blobs of the view
+     * \return \ref SparseBlockRef to the value
+     */
+    template<
+        std::size_t... T_datumDomainCoord,
+        typename T_Blobs
+    >
+    auto
+    compute(
+        UserDomain const coord,
+        T_Blobs & blobs
+    ) const
+    -> SparseBlockRef<
+        SparseBlockGrid,
+        T_Blobs,
+        T_datumDomainCoord...
+    >
+    {
+        return SparseBlockRef<
+            SparseBlockGrid,
+            T_Blobs,
+            T_datumDomainCoord...
+        >(
+            *this,
+            coord,
+            blobs
+        );
+    }
+
+    /** Gives the block containing a coordinate a slot in the pool if it does
+     *  not have one yet. Not thread safe.
+     * \param coord any coordinate inside the block
+     * \return false if the pool is exhausted, otherwise true
+     */
+    auto
+    activate( UserDomain const coord ) const
+    -> bool
+    {
+        std::size_t & slot = blockTable[ blockIndex( coord ) ];
+        if ( slot != 0 )
+            return true;
+        if ( activeBlockCount() == blockCapacity )
+            return false;
+        slot = ++blockTable[ blockCount() ];
+        return true;
+    }
+
+    /** Checks whether the block containing a coordinate has a slot in the pool.
+     * \param coord any coordinate inside the block
+     * \return true if the block is activated
+     */
+    auto
+    isActive( UserDomain const coord ) const
+    -> bool
+    {
+        return blockTable[ blockIndex( coord ) ] != 0;
+    }
+
+    /// \return number of activated blocks
+    auto
+    activeBlockCount() const
+    -> std::size_t
+    {
+        return blockTable[ blockCount() ];
+    }
+
+    UserDomainSize const userDomainSize;
+    /// number of blocks in every dimension
+    UserDomain const blockGridSize;
+    /// number of blocks which can be activated at most
+    std::size_t const blockCapacity;
+    BlockMapping const blockMapping;
+
+private:
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    blockGrid( UserDomainSize const & size )
+    -> UserDomain
+    {
+        UserDomain result;
+        for ( std::size_t i = 0; i < UserDomain::count; ++i )
+            result[ i ] = IndexType(
+                ( size[ i ] + blockExtent - 1 ) / blockExtent
+            );
+        return result;
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    blockCount() const
+    -> std::size_t
+    {
+        return ExtentUserDomainAdress< UserDomain::count >()( blockGridSize );
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    blockIndex( UserDomain const & coord ) const
+    -> IndexType
+    {
+        UserDomain block( coord );
+        for ( std::size_t i = 0; i < UserDomain::count; ++i )
+            block[ i ] /= IndexType( blockExtent );
+        return LinearizeUserDomainAdress< UserDomain::count >()(
+            block,
+            blockGridSize
+        );
+    }
+
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    coordInBlock( UserDomain const & coord )
+    -> typename BlockMapping::UserDomain
+    {
+        typename BlockMapping::UserDomain result;
+        for ( std::size_t i = 0; i < UserDomain::count; ++i )
+            result[ i ] = coord[ i ] % IndexType( blockExtent );
+        return result;
+    }
+
+    std::shared_ptr< std::size_t > blockTableOwner;
+    /// slot of every block (0 for the background) and the number of used slots
+    std::size_t * blockTable;
+};
+
+} // namespace mapping
+
+} // namespace llama
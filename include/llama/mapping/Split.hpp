@@ -0,0 +1,273 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <boost/mp11.hpp>
+
+#include "../Types.hpp"
+#include "../GetType.hpp"
+#include "../UserDomain.hpp"
+#include "Reorder.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+namespace internal
+{
+
+template<
+    typename T_DatumDomain,
+    typename T_Selection
+>
+struct IsSelectedLeaf
+{
+    template< typename T_LeafIndex >
+    using fn = boost::mp11::mp_to_bool<
+        boost::mp11::mp_count_if<
+            T_Selection,
+            IsPrefixOfCoord< boost::mp11::mp_at<
+                FlatDatumCoords< T_DatumDomain >,
+                T_LeafIndex
+            > >::template fn
+        >
+    >;
+};
+
+template< bool T_selected >
+struct SplitDispatch
+{
+    template<
+        std::size_t T_leafIndex,
+        typename T_Split
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobByte(
+        T_Split const & split,
+        typename T_Split::UserDomain const coord
+    )
+    -> typename T_Split::IndexType
+    {
+        return split.mappingA.template getBlobByte< boost::mp11::mp_find<
+            typename T_Split::LeavesA,
+            boost::mp11::mp_size_t< T_leafIndex >
+        >::value >( coord );
+    }
+
+    template<
+        std::size_t T_leafIndex,
+        typename T_Split
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobNr(
+        T_Split const & split,
+        typename T_Split::UserDomain const coord
+    )
+    -> std::size_t
+    {
+        return split.mappingA.template getBlobNr< boost::mp11::mp_find<
+            typename T_Split::LeavesA,
+            boost::mp11::mp_size_t< T_leafIndex >
+        >::value >( coord );
+    }
+};
+
+template< >
+struct SplitDispatch< false >
+{
+    template<
+        std::size_t T_leafIndex,
+        typename T_Split
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobByte(
+        T_Split const & split,
+        typename T_Split::UserDomain const coord
+    )
+    -> typename T_Split::IndexType
+    {
+        return split.mappingB.template getBlobByte< boost::mp11::mp_find<
+            typename T_Split::LeavesB,
+            boost::mp11::mp_size_t< T_leafIndex >
+        >::value >( coord );
+    }
+
+    template<
+        std::size_t T_leafIndex,
+        typename T_Split
+    >
+    LLAMA_FN_HOST_ACC_INLINE
+    static
+    auto
+    getBlobNr(
+        T_Split const & split,
+        typename T_Split::UserDomain const coord
+    )
+    -> std::size_t
+    {
+        return T_Split::MappingA::blobCount
+            + split.mappingB.template getBlobNr< boost::mp11::mp_find<
+                typename T_Split::LeavesB,
+                boost::mp11::mp_size_t< T_leafIndex >
+            >::value >( coord );
+    }
+};
+
+} // namespace internal
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory.
+ *  For the interface details see \ref Factory. The leaves of the datum domain
+ *  are split in two groups, e.g. hot and cold fields, and every group is laid
+ *  out by its own mapping in its own blobs. The blobs of the first mapping
+ *  come first, followed by the blobs of the second mapping. Both mappings get
+ *  a flat datum domain of their leaves in the original order.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_Selection `boost::mp11::mp_list` of \ref DatumCoord of the leaves
+ *  or whole branches given to `T_MappingA`, e.g. gotten with
+ *  \ref GetCoordFromUID. All other leaves are given to `T_MappingB`.
+ * \tparam T_MappingA mapping template taking a user domain and a datum domain
+ *  used for the selected leaves, e.g. \ref SoA. Mappings with further
+ *  non-type template parameters can be given with an alias template.
+ * \tparam T_MappingB mapping template like `T_MappingA` used for all other
+ *  leaves
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_Selection,
+    template< typename... > class T_MappingA,
+    template< typename... > class T_MappingB
+>
+struct Split
+{
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    using IndexType = UserDomainIndexType< UserDomain >;
+    using DatumDomain = T_DatumDomain;
+    /// leaf indices given to the first mapping
+    using LeavesA = boost::mp11::mp_copy_if<
+        internal::LeafIndices< DatumDomain >,
+        internal::IsSelectedLeaf<
+            DatumDomain,
+            T_Selection
+        >::template fn
+    >;
+    /// leaf indices given to the second mapping
+    using LeavesB = boost::mp11::mp_remove_if<
+        internal::LeafIndices< DatumDomain >,
+        internal::IsSelectedLeaf<
+            DatumDomain,
+            T_Selection
+        >::template fn
+    >;
+    using MappingA = T_MappingA<
+        UserDomainSize,
+        boost::mp11::mp_transform<
+            internal::PermutedDatumElement< DatumDomain >::template fn,
+            LeavesA
+        >
+    >;
+    using MappingB = T_MappingB<
+        UserDomainSize,
+        boost::mp11::mp_transform<
+            internal::PermutedDatumElement< DatumDomain >::template fn,
+            LeavesB
+        >
+    >;
+    static constexpr std::size_t blobCount =
+        MappingA::blobCount + MappingB::blobCount;
+
+    /// \param size size of the user domain
+    LLAMA_FN_HOST_ACC_INLINE
+    Split( UserDomainSize const size ) :
+        userDomainSize( size ),
+        mappingA( size ),
+        mappingB( size )
+    { }
+
+    Split() = default;
+    Split( Split const & ) = default;
+    Split( Split && ) = default;
+    ~Split( ) = default;
+
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobSize( std::size_t const blobNr ) const
+    -> std::size_t
+    {
+        return blobNr < MappingA::blobCount ?
+            mappingA.getBlobSize( blobNr ) :
+            mappingB.getBlobSize( blobNr - MappingA::blobCount );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobByte( UserDomain const coord ) const
+    -> IndexType
+    {
+        return Dispatch< T_datumDomainCoord... >::template getBlobByte<
+            LinearLeafIndex<
+                DatumDomain,
+                T_datumDomainCoord...
+            >::value
+        >( *this, coord );
+    }
+
+    template< std::size_t... T_datumDomainCoord >
+    LLAMA_FN_HOST_ACC_INLINE
+    auto
+    getBlobNr( UserDomain const coord ) const
+    -> std::size_t
+    {
+        return Dispatch< T_datumDomainCoord... >::template getBlobNr<
+            LinearLeafIndex<
+                DatumDomain,
+                T_datumDomainCoord...
+            >::value
+        >( *this, coord );
+    }
+
+    UserDomainSize const userDomainSize;
+    MappingA const mappingA;
+    MappingB const mappingB;
+
+private:
+    template< std::size_t... T_datumDomainCoord >
+    using Dispatch = internal::SplitDispatch< boost::mp11::mp_contains<
+        LeavesA,
+        boost::mp11::mp_size_t< LinearLeafIndex<
+            DatumDomain,
+            T_datumDomainCoord...
+        >::value >
+    >::value >;
+};
+
+} // namespace mapping
+
+} // namespace llama
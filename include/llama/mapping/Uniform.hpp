@@ -0,0 +1,63 @@
+/* Copyright 2018 Alexander Matthes
+ *
+ * This file is part of LLAMA.
+ *
+ * LLAMA is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * LLAMA is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with LLAMA.  If not, see <www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "One.hpp"
+#include "SoA.hpp"
+#include "Split.hpp"
+
+namespace llama
+{
+
+namespace mapping
+{
+
+/** Mapping which can be used for creating a \ref View with a \ref Factory.
+ *  For the interface details see \ref Factory. Selected leaves which have the
+ *  same value for every datum, e.g. the mass of equal particles or per
+ *  species constants, are stored only once per view in the first blob with
+ *  \ref One. Their byte position doesn't depend on the user domain
+ *  coordinate, so reading them needs no offset computation. Writing such a
+ *  leaf of any datum changes it for all datums. All other leaves are laid out
+ *  by a second mapping in the blobs after the first one, see \ref Split.
+ * \tparam T_UserDomain type of the user domain
+ * \tparam T_DatumDomain type of the datum domain
+ * \tparam T_UniformLeaves `boost::mp11::mp_list` of \ref DatumCoord of the
+ *  leaves or whole branches stored once, e.g. gotten with
+ *  \ref GetCoordFromUID
+ * \tparam T_RestMapping mapping template taking a user domain and a datum
+ *  domain used for all other leaves, e.g. \ref SoA (default) or \ref AoS
+ */
+template<
+    typename T_UserDomain,
+    typename T_DatumDomain,
+    typename T_UniformLeaves,
+    template< typename... > class T_RestMapping = SoA
+>
+using Uniform = Split<
+    T_UserDomain,
+    T_DatumDomain,
+    T_UniformLeaves,
+    One,
+    T_RestMapping
+>;
+
+} // namespace mapping
+
+} // namespace llama
@@ -47,7 +47,8 @@ namespace tree
 
 /** Free describable mapping which can be used for creating a \ref View with a
  *  \ref Factory. For the interface details see \ref Factory.
- * \tparam T_UserDomain type of the user domain
+ * \tparam T_UserDomain type of the user domain, a \ref StaticUserDomain is
+ *  converted to a run time \ref UserDomain
  * \tparam T_DatumDomain type of the datum domain
  * \tparam T_TreeOperationList the type of a compile time list (\ref Tuple) used
  *  to define the tree mapping
@@ -59,7 +60,12 @@ template<
 >
 struct Mapping
 {
-    using UserDomain = T_UserDomain;
+    using UserDomain = UserDomainCoord< T_UserDomain >;
+    using UserDomainSize = T_UserDomain;
+    /** type of the byte offsets in the blob, the tree itself is still
+     *  calculated with `std::size_t`
+     */
+    using IndexType = UserDomainIndexType< UserDomain >;
     using DatumDomain = T_DatumDomain;
     using BasicTree = TreeFromDomains<
         UserDomain,
@@ -89,11 +95,11 @@ struct Mapping
      */
     LLAMA_FN_HOST_ACC_INLINE
     Mapping(
-        UserDomain const size,
+        UserDomainSize const size,
         T_TreeOperationList const treeOperationList
     ) :
         userDomainSize( size ),
-        basicTree( setUserDomainInTree< DatumDomain >( size ) ),
+        basicTree( setUserDomainInTree< DatumDomain >( userDomainSize ) ),
         mergedFunctors(
             basicTree,
             treeOperationList
@@ -118,7 +124,7 @@ struct Mapping
     LLAMA_FN_HOST_ACC_INLINE
     auto
     getBlobByte( UserDomain const coord ) const
-    -> std::size_t
+    -> IndexType
     {
         auto const basicTreeCoord = getBasicTreeCoordFromDomains<
             DatumCoord< T_datumDomainCoord... >
@@ -129,10 +135,10 @@ struct Mapping
             basicTree
         );
 
-        return getTreeBlobByte(
+        return IndexType( getTreeBlobByte(
             resultTree,
             resultTreeCoord
-        );
+        ) );
     }
 
     template< std::size_t... T_datumDomainCoord >